@@ -9,7 +9,7 @@
 #include <ctime>
 #include <unordered_set>
 
-#include "weighted_graph.h"
+#include "weighted_graph.hpp"
 #include "test_helper.cpp"
 
 class Management : public CxxTest::GlobalFixture
@@ -845,6 +845,107 @@ public:
 		TS_ASSERT_EQUALS(graph_bfs, reference_bfs);
 	}
 
+	void testTraversalRanges()
+	{
+
+		weighted_graph<int> g;
+		int r = (std::rand() % 20) + 1;
+		std::unordered_map<int, std::unordered_set<int>> adj_list;
+
+		for (int i = 0; i < r; ++i)
+		{
+			g.add_vertex(i);
+			adj_list.insert({i, std::unordered_set<int>()});
+		}
+
+		for (int i = 0; i < r; ++i)
+		{
+			for (int j = i + 1; j < r; ++j)
+			{
+				if (std::rand() % 4 == 1)
+				{
+					g.add_edge(i, j, (std::rand() % 10) + 1);
+					adj_list[i].insert(j);
+					adj_list[j].insert(i);
+				}
+			}
+		}
+
+		for (int start_vertex = 0; start_vertex < r; ++start_vertex)
+		{
+			std::vector<int> range_dfs;
+			for (int v : g.depth_first_range(start_vertex))
+			{
+				range_dfs.push_back(v);
+			}
+			std::vector<int> range_bfs;
+			for (int v : g.breadth_first_range(start_vertex))
+			{
+				range_bfs.push_back(v);
+			}
+
+			TS_ASSERT_EQUALS(range_dfs, g.depth_first(start_vertex));
+			TS_ASSERT_EQUALS(range_dfs, dfs(adj_list, start_vertex));
+			TS_ASSERT_EQUALS(range_bfs, g.breadth_first(start_vertex));
+			TS_ASSERT_EQUALS(range_bfs, bfs(adj_list, start_vertex));
+		}
+
+		// A start vertex that is not in the graph gives an empty range
+		TS_ASSERT(g.depth_first_range(r).begin() == g.depth_first_range(r).end());
+		TS_ASSERT(g.breadth_first_range(-1).begin() == g.breadth_first_range(-1).end());
+	}
+
+	void testTraversalRangeEarlyExit()
+	{
+
+		weighted_graph<int> g;
+		int r = (std::rand() % 20) + 2;
+
+		// A path, so every traversal from 0 visits the vertices in order
+		for (int i = 0; i < r; ++i)
+		{
+			g.add_vertex(i);
+		}
+		for (int i = 0; i + 1 < r; ++i)
+		{
+			g.add_edge(i, i + 1, 1);
+		}
+
+		int stop = std::rand() % r;
+		for (bool breadth : {false, true})
+		{
+			auto range = breadth ? g.breadth_first_range(0) : g.depth_first_range(0);
+			std::vector<int> visited;
+			for (int v : range)
+			{
+				visited.push_back(v);
+				if (v == stop)
+				{
+					break;
+				}
+			}
+
+			TS_ASSERT_EQUALS(visited.size(), stop + 1);
+			for (int i = 0; i < visited.size(); ++i)
+			{
+				TS_ASSERT_EQUALS(visited[i], i);
+			}
+
+			// The range carries on from where it was left
+			auto it = range.begin();
+			TS_ASSERT_EQUALS(*it, stop);
+			++it;
+			if (stop + 1 < r)
+			{
+				TS_ASSERT_EQUALS(*it, stop + 1);
+			}
+			else
+			{
+				TS_ASSERT(it == range.end());
+			}
+		}
+	}
+
 	void testMST()
 	{
 
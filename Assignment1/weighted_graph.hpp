@@ -52,6 +52,7 @@ private:
 		weighted_graph<vertex> owner; // the owner of the neighbour iterator
 		int row_index; // the index within the adjacency matrix that we will be iterating through
 		int position; // the current iterator position
+		std::pair<vertex, int> current; // the neighbour and weight operator-> last pointed to
 		bool is_valid_neighbour(int) const; // determines whether the current position is a neighbour of the vertex
 		int get_next(int); // gets the next neighbour
 
@@ -65,7 +66,34 @@ private:
 		neighbour_iterator operator++(); // increments throughout the neighbours of the vertex, pre-incrememntation
 		neighbour_iterator operator++(int);	// incrememnts throughout the neighbours of the vertex, post incremementation
 		const std::pair<vertex, int> operator*(); // returns a pair of values, the first being the neighbour vertex, the second being the weight
-		const std::pair<const vertex, int>* operator->(); // returns a pointer of a pair of values, the first being the neighbour vertex, the second being the weight
+		const std::pair<vertex, int>* operator->(); // returns a pointer of a pair of values, the first being the neighbour vertex, the second being the weight
+	};
+
+	class traversal_range {
+	private:
+		const weighted_graph<vertex>* owner; // the graph being traversed, which must not change while the range is in use
+		std::vector<bool> visited; // marks the indexes that have already been visited
+		std::deque<int> unprocessed; // the indexes waiting to be visited
+		int current; // the index of the vertex the traversal is at, or -1 once it has finished
+		bool breadth; // true for a breadth-first traversal, false for a depth-first one
+		void advance(); // moves on to the next vertex that has not been visited yet
+
+	public:
+		class iterator {
+		private:
+			traversal_range* range; // the range being iterated, or nullptr for the end iterator
+
+		public:
+			iterator(traversal_range*); // constructor
+			bool operator==(const iterator&) const; // checks if the two iterators are equal
+			bool operator!=(const iterator&) const; // checks if the two iterators are not equal
+			iterator& operator++(); // moves the traversal on to its next vertex
+			const vertex& operator*() const; // returns the vertex the traversal is at
+		};
+
+		traversal_range(const weighted_graph&, const vertex&, bool); // constructor
+		iterator begin(); // returns an iterator at the vertex the traversal is at
+		iterator end(); // returns the iterator that a finished traversal is equal to
 	};
 	
 	public:
@@ -103,6 +131,8 @@ private:
 
 	std::vector<vertex> depth_first(const vertex&); // Returns the vertices of the graph in the order they are visited in by a depth-first traversal starting at the given vertex.
 	std::vector<vertex> breadth_first(const vertex&); // Returns the vertices of the graph in the order they are visisted in by a breadth-first traversal starting at the given vertex.
+	traversal_range depth_first_range(const vertex&) const; // Returns a range that visits the vertices in the same order as depth_first, one at a time, so a caller can stop as soon as it has found what it needs.
+	traversal_range breadth_first_range(const vertex&) const; // Returns a range that visits the vertices in the same order as breadth_first, one at a time.
 	
 	weighted_graph<vertex> mst(); //Returns a minimum spanning tree of the graph.
 };
@@ -165,8 +195,7 @@ template <typename vertex> const vertex weighted_graph<vertex>::graph_iterator::
 
 template <typename vertex> const vertex* weighted_graph<vertex>::graph_iterator::operator->() { 
 		// returns a pointer of the vertex at the current position
-		auto v = owner.vertices[position]; 
-		return &v;
+		return &owner.vertices[position];
 }
 
 //////////////////////////////////////////
@@ -177,7 +206,7 @@ template <typename vertex> const vertex* weighted_graph<vertex>::graph_iterator:
 
 template <typename vertex> bool weighted_graph<vertex>::neighbour_iterator::is_valid_neighbour(int pos) const {
 		// neighbour is valid if there is an edge present, also prevents from iterating past the end of the adjacency matrix
-		return !(owner.adj_matrix[row_index][pos] == 0 && pos < owner.adj_matrix[row_index].size());
+		return !(pos < owner.adj_matrix[row_index].size() && owner.adj_matrix[row_index][pos] == 0);
 }
 
 template <typename vertex> int weighted_graph<vertex>::neighbour_iterator::get_next(int current_position) {
@@ -219,7 +248,7 @@ template <typename vertex> bool weighted_graph<vertex>::neighbour_iterator::oper
 
 template <typename vertex> bool weighted_graph<vertex>::neighbour_iterator::operator!=(const neighbour_iterator& it) const { 
 		// check if iterator positions are not equal
-		return this->row_index != it.row_index && this->position != it.position; 
+		return !(*this == it); 
 }
 
 template <typename vertex> typename weighted_graph<vertex>::neighbour_iterator weighted_graph<vertex>::neighbour_iterator::operator++() { 
@@ -240,10 +269,11 @@ template <typename vertex> const std::pair<vertex, int> weighted_graph<vertex>::
 		return p; 
 }
 
-template <typename vertex> const std::pair<const vertex, int>* weighted_graph<vertex>::neighbour_iterator::operator->() { 
-		// return a reference of a pair of values: the second neighbour index, as well as the weight
-		std::pair<const vertex,int> p(owner.vertices[position], owner.adj_matrix[row_index][position]); 
-		return &p; 
+template <typename vertex> const std::pair<vertex, int>* weighted_graph<vertex>::neighbour_iterator::operator->() { 
+		// return a reference of a pair of values: the second neighbour index, as well as the weight,
+		// kept in the iterator so that it outlives the call
+		current = std::pair<vertex,int>(owner.vertices[position], owner.adj_matrix[row_index][position]); 
+		return &current; 
 }
 
 //////////////////////////////////////////
@@ -269,7 +299,95 @@ template <typename vertex>	typename weighted_graph<vertex>::neighbour_iterator w
 
 template <typename vertex>	typename weighted_graph<vertex>::neighbour_iterator weighted_graph<vertex>::neighbours_end(const vertex& u) {
 	// construct the ending neighbour iterator
-	return neighbour_iterator(weighted_graph<vertex>(), u, adj_matrix[get_index(u)].size());
+	return neighbour_iterator(*this, u, adj_matrix[get_index(u)].size());
+}
+
+//////////////////////////////////////////
+//                              				//
+// 						TRAVERSAL RANGE						//
+//                              				//
+//////////////////////////////////////////
+
+template <typename vertex> weighted_graph<vertex>::traversal_range::traversal_range(const weighted_graph & g, const vertex& start_vertex, bool breadth_first) {
+	// constructor, set initial values
+	owner = &g;
+	visited.assign(g.vertices.size(), false);
+	breadth = breadth_first;
+	// the traversal starts at start_vertex, or has already finished if it is not in the graph
+	current = g.get_index(start_vertex);
+	if (current >= 0) {
+		visited[current] = true;
+	}
+}
+
+template <typename vertex> void weighted_graph<vertex>::traversal_range::advance() {
+	// queue up the unvisited neighbours of the vertex we are leaving
+	if (breadth) {
+		for (unsigned i = 0; i < owner->vertices.size(); i++) {
+			if (owner->adj_matrix[current][i] > 0 && !visited[i]) {
+				unprocessed.push_back(i);
+			}
+		}
+	}
+	else {
+		// pushed in reverse, so that the lowest index is the next one taken off the back
+		for (unsigned i = owner->vertices.size(); i != 0; i--) {
+			if (owner->adj_matrix[current][i-1] > 0 && !visited[i-1]) {
+				unprocessed.push_back(i-1);
+			}
+		}
+	}
+	current = -1;
+	// take indexes off the front (breadth-first) or the back (depth-first) until one has not been visited
+	while (!unprocessed.empty()) {
+		int index = breadth ? unprocessed.front() : unprocessed.back();
+		if (breadth) {
+			unprocessed.pop_front();
+		}
+		else {
+			unprocessed.pop_back();
+		}
+		if (!visited[index]) {
+			visited[index] = true;
+			current = index;
+			return;
+		}
+	}
+}
+
+template <typename vertex> typename weighted_graph<vertex>::traversal_range::iterator weighted_graph<vertex>::traversal_range::begin() {
+	return iterator(this);
+}
+
+template <typename vertex> typename weighted_graph<vertex>::traversal_range::iterator weighted_graph<vertex>::traversal_range::end() {
+	return iterator(nullptr);
+}
+
+template <typename vertex> weighted_graph<vertex>::traversal_range::iterator::iterator(traversal_range* r) {
+	// constructor, set initial values
+	range = r;
+}
+
+template <typename vertex> bool weighted_graph<vertex>::traversal_range::iterator::operator==(const iterator& it) const {
+	// an iterator over a finished traversal is the same as the end iterator
+	bool this_done = range == nullptr || range->current < 0;
+	bool it_done = it.range == nullptr || it.range->current < 0;
+	return (this_done && it_done) || (!this_done && !it_done && range == it.range);
+}
+
+template <typename vertex> bool weighted_graph<vertex>::traversal_range::iterator::operator!=(const iterator& it) const {
+	return !(*this == it);
+}
+
+template <typename vertex> typename weighted_graph<vertex>::traversal_range::iterator& weighted_graph<vertex>::traversal_range::iterator::operator++() {
+	// move the traversal on to its next vertex
+	range->advance();
+	return *this;
+}
+
+template <typename vertex> const vertex& weighted_graph<vertex>::traversal_range::iterator::operator*() const {
+	// return the vertex the traversal is at
+	return range->owner->vertices[range->current];
 }
 
 //////////////////////////////////////////
@@ -511,80 +629,38 @@ template <typename vertex>	std::vector<vertex> weighted_graph<vertex>::get_neigh
 }
 
 template <typename vertex> std::vector<vertex> weighted_graph<vertex>::depth_first(const vertex& start_vertex){
-	bool visited[vertices.size()];
-	std::stack<vertex> unprocessed;
 	std::vector<vertex> ordered;
-	// if the index of the start_vertex is valid
-	if (get_index(start_vertex) >= 0) {
-		// set all index values to represent that they have not been visited yet 
-		for (unsigned i = 0; i < vertices.size(); i++){
-			visited[i] = false;
-		}
-		// push the start_vertex to the unprocessed vertices stack
-		unprocessed.push(start_vertex);
-		// while there is still values in the unprocessed stack
-		while (!unprocessed.empty()){
-			// get the index of the top vertex and remove it from the stack	
-			int index = get_index(unprocessed.top());
-			unprocessed.pop();
-			// if it hasn't been visted yet
-			if (!visited[index]){
-				// set it to visited
-				visited[index] = true;
-				// add the vertex to the ordered list
-				ordered.push_back(vertices[index]);
-				for (unsigned i = vertices.size(); i != 0; i--){
-					// if the vertex contains a neighbour
-					if (adj_matrix[index][i-1] > 0){
-						// add the neighbour to the unprocessed stack
-						unprocessed.push(vertices[i-1]);
-					}
-				}
-			}
-		}
+	// collect every vertex the lazy traversal visits
+	for (const vertex& v : depth_first_range(start_vertex)){
+		ordered.push_back(v);
 	}
 	return ordered;
 }
 
 template <typename vertex> std::vector<vertex> weighted_graph<vertex>::breadth_first(const vertex& start_vertex){
-	bool visited[vertices.size()];
-	std::queue<vertex> unprocessed;
 	std::vector<vertex> ordered;
-	// if the index of the start_vertex is valid
-	if (get_index(start_vertex) >= 0) {
-		// set all index values to represent that they have not been visited yet 
-		for (unsigned i = 0; i < vertices.size(); i++){
-			visited[i] = false;
-		}
-		// add the start_vertex to the unprocessed queue
-		unprocessed.push(start_vertex);
-		// while there is still values in the unprocessed stack
-		while (!unprocessed.empty()){
-			// get the index of the vertex at the front of the queue and remove it
-			int index = get_index(unprocessed.front());
-			unprocessed.pop();
-			// if it hasn't been visited yet
-			if (!visited[index]){
-				// set it to visited
-				visited[index] = true;
-				// add the vertex to the ordered list
-				ordered.push_back(vertices[index]);
-				for (unsigned i = 0; i < vertices.size(); i++){
-					// if the vertex contains a neighbour
-					if (adj_matrix[index][i] > 0){
-						// add the neighbour to the end of the unprocessed queue.
-						unprocessed.push(vertices[i]);
-					}
-				}
-			}
-		}
+	// collect every vertex the lazy traversal visits
+	for (const vertex& v : breadth_first_range(start_vertex)){
+		ordered.push_back(v);
 	}
 	return ordered;
 }
+
+template <typename vertex> typename weighted_graph<vertex>::traversal_range weighted_graph<vertex>::depth_first_range(const vertex& start_vertex) const {
+	return traversal_range(*this, start_vertex, false);
+}
+
+template <typename vertex> typename weighted_graph<vertex>::traversal_range weighted_graph<vertex>::breadth_first_range(const vertex& start_vertex) const {
+	return traversal_range(*this, start_vertex, true);
+}
 	
 template <typename vertex>	weighted_graph<vertex> weighted_graph<vertex>::mst() {
 	// graph to return
 	weighted_graph<vertex> mst_graph;
+	// an empty graph is its own mst
+	if (vertices.empty()) {
+		return mst_graph;
+	}
 	// new vector with size equal to the number of vertices
 	// used to store the constructed mst
 	std::vector<int> parent(vertices.size()); 
@@ -621,8 +697,8 @@ template <typename vertex>	weighted_graph<vertex> weighted_graph<vertex>::mst()
 		mst_graph.add_vertex(vertices[i]);
 	}
 	
-	// add the chosen mst edges and weights to the new graph
-	for (unsigned i = 0; i < vertices.size(); ++i) {
+	// add the chosen mst edges and weights to the new graph, skipping the root, which has no parent
+	for (unsigned i = 1; i < vertices.size(); ++i) {
 		mst_graph.add_edge(
 			vertices[parent[i]],
 			vertices[i],
@@ -0,0 +1,69 @@
+#ifndef BENCH_HELPER
+#define BENCH_HELPER
+
+#include <chrono>
+#include <random>
+#include <vector>
+#include <utility>
+#include <iostream>
+#include <string>
+
+#include "weighted_graph.hpp"
+
+// Returns a connected random graph on the vertices 0..n-1: a random spanning tree plus
+// extra_edges further random edges, with weights drawn uniformly from 1..max_weight.
+inline weighted_graph<int> random_connected_graph(int n, int extra_edges, int max_weight, unsigned seed){
+
+	std::mt19937 rng(seed);
+	weighted_graph<int> g;
+	for (int i = 0; i < n; ++i) g.add_vertex(i);
+	
+	for (int i = 1; i < n; ++i){
+		std::uniform_int_distribution<int> parent(0, i - 1);
+		g.add_edge(i, parent(rng), rng()%max_weight + 1);
+	}
+	
+	std::uniform_int_distribution<int> any(0, n - 1);
+	for (int added = 0; added < extra_edges && n > 1;){
+		int u = any(rng);
+		int v = any(rng);
+		if (u != v && !g.are_adjacent(u, v)){
+			g.add_edge(u, v, rng()%max_weight + 1);
+			++added;
+		}
+	}
+	
+	return g;
+
+}
+
+// Returns a rows x cols grid graph, the usual stand-in for a road network.
+inline weighted_graph<int> random_grid_graph(int rows, int cols, int max_weight, unsigned seed){
+
+	std::mt19937 rng(seed);
+	weighted_graph<int> g;
+	for (int i = 0; i < rows*cols; ++i) g.add_vertex(i);
+	
+	for (int r = 0; r < rows; ++r){
+		for (int c = 0; c < cols; ++c){
+			if (c + 1 < cols) g.add_edge(r*cols + c, r*cols + c + 1, rng()%max_weight + 1);
+			if (r + 1 < rows) g.add_edge(r*cols + c, (r + 1)*cols + c, rng()%max_weight + 1);
+		}
+	}
+	
+	return g;
+
+}
+
+// Runs f once and returns the elapsed wall time in milliseconds.
+template <typename F>
+double time_ms(F f){
+
+	auto start = std::chrono::steady_clock::now();
+	f();
+	auto end = std::chrono::steady_clock::now();
+	return std::chrono::duration<double, std::milli>(end - start).count();
+
+}
+
+#endif
@@ -0,0 +1,44 @@
+// Measures exact and sampled Brandes betweenness centrality from 1 to 64 threads, and how far the
+// sampled estimates stray from the exact values once both are normalised by the number of pairs.
+// Build from this directory with: g++ -std=c++17 -O2 -pthread -I.. betweenness_benchmark.cpp
+
+#include <cmath>
+#include <iostream>
+#include <unordered_map>
+
+#include "bench_helper.cpp"
+#include "betweenness.cpp"
+
+int main(){
+
+	const int n = 10000;
+	const int extra_edges = 20000;
+	const double epsilon = 0.05;
+	const double delta = 0.1;
+	
+	auto g = random_connected_graph(n, extra_edges, 10, 42);
+	std::cout << "graph: " << g.num_vertices() << " vertices, " << g.num_edges() << " edges" << std::endl;
+	std::cout << "sampled sources: " << betweenness_sample_size(n, epsilon, delta) << " of " << n << std::endl;
+	
+	std::unordered_map<int, double> expected;
+	bool mismatch = false;
+	for (int threads = 1; threads <= 64; threads *= 2){
+		thread_pool pool(threads);
+		std::unordered_map<int, double> exact, approximate;
+		double all = time_ms([&]{ exact = betweenness_centrality(g, pool); });
+		double sampled = time_ms([&]{ approximate = approximate_betweenness_centrality(g, pool, epsilon, delta, 7); });
+		if (expected.empty()) expected = exact;
+		
+		double pairs = (n - 1.0) * (n - 2.0) / 2, worst = 0;
+		for (auto& e : expected){
+			if (std::fabs(exact.at(e.first) - e.second) > 1e-6 * (1 + e.second)) mismatch = true;
+			worst = std::max(worst, std::fabs(approximate.at(e.first) - e.second) / pairs);
+		}
+		if (worst > epsilon * n / (n - 1)) mismatch = true;
+		std::cout << threads << " threads: " << all << " ms exact, " << sampled << " ms sampled, worst error " << worst << std::endl;
+	}
+	
+	std::cout << (mismatch ? "centrality mismatch" : "centralities match") << std::endl;
+	return mismatch;
+
+}
@@ -0,0 +1,62 @@
+// Measures radius-bounded and k-nearest queries against full searches on a road-like grid, all
+// reusing one workspace, so the bounded queries pay only for the region they explore.
+// Build from this directory with: g++ -std=c++17 -O2 -pthread -I.. bounded_dijkstras_benchmark.cpp
+
+#include <iostream>
+#include <random>
+
+#include "bench_helper.cpp"
+#include "graph_algorithms.cpp"
+
+int main(){
+
+	const int rows = 500;
+	const int queries = 1000;
+	const int radius = 50;
+	const int k = 100;
+	
+	auto g = random_grid_graph(rows, rows, 10, 42);
+	csr_graph<int> c(g);
+	traversal_workspace ws(c.num_vertices());
+	std::cout << "graph: " << g.num_vertices() << " vertices, " << g.num_edges() << " edges" << std::endl;
+	
+	std::mt19937 rng(7);
+	std::vector<int> sources(queries);
+	for (auto& s : sources) s = rng()%c.num_vertices();
+	
+	// The full search, keeping what the bounded ones would return
+	long long full_found = 0, nearest_total = 0;
+	double full = time_ms([&]{
+		for (auto s : sources){
+			dijkstras(c, s, ws);
+			for (int u : ws.frontier){
+				if (ws.distance(u) > radius) break;
+				++full_found;
+			}
+			for (int i = 0; i < k && i < ws.frontier.size(); ++i) nearest_total += ws.distance(ws.frontier[i]);
+		}
+	});
+	std::cout << "full searches: " << full / queries << " ms per query" << std::endl;
+	
+	std::vector<std::pair<int, int>> found;
+	long long within_found = 0, k_total = 0;
+	double within = time_ms([&]{
+		for (auto s : sources){
+			dijkstras_within(c, s, radius, ws, found);
+			within_found += found.size();
+		}
+	});
+	double nearest = time_ms([&]{
+		for (auto s : sources){
+			k_nearest(c, s, k, ws, found);
+			for (auto& f : found) k_total += f.second;
+		}
+	});
+	std::cout << "within " << radius << ": " << within / queries << " ms per query, " << double(within_found) / queries << " vertices on average" << std::endl;
+	std::cout << k << " nearest: " << nearest / queries << " ms per query" << std::endl;
+	
+	bool match = within_found == full_found && k_total == nearest_total;
+	std::cout << (match ? "results match" : "result mismatch") << std::endl;
+	return !match;
+
+}
@@ -0,0 +1,45 @@
+// Measures how the Afforest connected components engine scales from 1 to 64 threads,
+// against the single-threaded union-find component_labels.
+// Build from this directory with: g++ -std=c++17 -O2 -pthread -I.. components_benchmark.cpp
+
+#include <iostream>
+#include <vector>
+
+#include "bench_helper.cpp"
+#include "parallel_components.cpp"
+
+int main(){
+
+	const int n = 500000;
+	const int extra_edges = 1500000;
+	
+	// Cut some vertices loose, so there are small components as well as the giant one
+	auto g = random_connected_graph(n, extra_edges, 10, 42);
+	for (int i = 0; i < n; i += 1000){
+		std::vector<int> neighbours;
+		for (auto n_it = g.neighbours_begin(i); n_it != g.neighbours_end(i); ++n_it) neighbours.push_back(n_it->first);
+		for (auto v : neighbours) g.remove_edge(i, v);
+	}
+	csr_graph<int> c(g);
+	std::cout << "graph: " << g.num_vertices() << " vertices, " << g.num_edges() << " edges" << std::endl;
+	
+	component_labelling<int> expected;
+	double sequential = time_ms([&]{ expected = component_labels(g); });
+	std::cout << "component_labels: " << sequential << " ms, " << expected.sizes.size() << " components" << std::endl;
+	
+	bool mismatch = false;
+	for (int threads = 1; threads <= 64; threads *= 2){
+		thread_pool pool(threads);
+		component_labelling<int> labelling;
+		std::vector<int> ids;
+		double over_graph = time_ms([&]{ labelling = parallel_component_labels(g, pool); });
+		double over_csr = time_ms([&]{ ids = parallel_component_ids(c, pool); });
+		if (labelling.component != expected.component) mismatch = true;
+		std::cout << threads << " threads: " << over_graph << " ms over weighted_graph, "
+		          << over_csr << " ms over csr_graph" << std::endl;
+	}
+	
+	std::cout << (mismatch ? "labelling mismatch" : "labellings match") << std::endl;
+	return mismatch;
+
+}
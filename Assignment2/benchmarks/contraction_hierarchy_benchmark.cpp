@@ -0,0 +1,56 @@
+// Compares point-to-point query latency of a contraction hierarchy against dijkstras.
+// Build from this directory with: g++ -std=c++17 -O2 -I.. contraction_hierarchy_benchmark.cpp
+
+#include <iostream>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "bench_helper.cpp"
+#include "graph_algorithms.cpp"
+#include "contraction_hierarchy.hpp"
+
+int main(){
+
+	const int rows = 40;
+	const int cols = 40;
+	const int dijkstras_queries = 20;
+	const int ch_queries = 100000;
+	
+	auto g = random_grid_graph(rows, cols, 100, 42);
+	std::mt19937 rng(7);
+	std::uniform_int_distribution<int> any(0, rows*cols - 1);
+	
+	std::unique_ptr<contraction_hierarchy<int>> ch;
+	double preprocess = time_ms([&]{ ch = std::make_unique<contraction_hierarchy<int>>(g); });
+	std::cout << "graph: " << g.num_vertices() << " vertices, " << g.num_edges() << " edges" << std::endl;
+	std::cout << "preprocessing: " << preprocess << " ms, " << ch->num_shortcuts() << " shortcuts, "
+	          << ch->num_upward_edges() << " upward edges" << std::endl;
+	
+	// dijkstras settles the whole graph for every query, so it only gets a handful of them
+	std::vector<int> sources(dijkstras_queries), targets(dijkstras_queries), expected(dijkstras_queries);
+	for (int i = 0; i < dijkstras_queries; ++i){
+		sources[i] = any(rng);
+		targets[i] = any(rng);
+	}
+	double dijkstras_total = time_ms([&]{
+		for (int i = 0; i < dijkstras_queries; ++i) expected[i] = dijkstras(g, sources[i]).at(targets[i]);
+	});
+	// Checked against the hierarchy outside the timing, so the baseline is dijkstras alone
+	int mismatches = 0;
+	for (int i = 0; i < dijkstras_queries; ++i){
+		if (expected[i] != ch->distance(sources[i], targets[i])) ++mismatches;
+	}
+	
+	long long checksum = 0;
+	double ch_total = time_ms([&]{
+		for (int i = 0; i < ch_queries; ++i) checksum += ch->distance(any(rng), any(rng));
+	});
+	
+	std::cout << "dijkstras: " << dijkstras_total*1000/dijkstras_queries << " us/query" << std::endl;
+	std::cout << "contraction hierarchy: " << ch_total*1000/ch_queries << " us/query (checksum " << checksum << ")" << std::endl;
+	std::cout << "mismatches: " << mismatches << std::endl;
+	
+	return mismatches != 0;
+
+}
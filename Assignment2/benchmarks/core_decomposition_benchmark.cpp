@@ -0,0 +1,36 @@
+// Measures the bucket-based core decomposition against parallel peeling from 1 to 64 threads.
+// Build from this directory with: g++ -std=c++17 -O2 -pthread -I.. core_decomposition_benchmark.cpp
+
+#include <iostream>
+#include <vector>
+
+#include "bench_helper.cpp"
+#include "core_decomposition.cpp"
+
+int main(){
+
+	const int n = 500000;
+	const int extra_edges = 3000000;
+	
+	auto g = random_connected_graph(n, extra_edges, 1, 42);
+	csr_graph<int> c(g);
+	std::cout << "graph: " << g.num_vertices() << " vertices, " << g.num_edges() << " edges" << std::endl;
+	
+	std::vector<int> expected, order;
+	double sequential = time_ms([&]{ core_number_ids(c, expected, order); });
+	std::cout << "core_number_ids: " << sequential << " ms, degeneracy "
+	          << *std::max_element(expected.begin(), expected.end()) << std::endl;
+	
+	bool mismatch = false;
+	for (int threads = 1; threads <= 64; threads *= 2){
+		thread_pool pool(threads);
+		std::vector<int> core;
+		double parallel = time_ms([&]{ core = parallel_core_number_ids(c, pool); });
+		if (core != expected) mismatch = true;
+		std::cout << threads << " threads: " << parallel << " ms" << std::endl;
+	}
+	
+	std::cout << (mismatch ? "core mismatch" : "cores match") << std::endl;
+	return mismatch;
+
+}
@@ -0,0 +1,49 @@
+// Measures how many single source searches iFUB and the eccentricity bounds need for the diameter
+// of a large road-like grid and a random graph, against one search from every vertex.
+// Build from this directory with: g++ -std=c++17 -O2 -pthread -I.. diameter_benchmark.cpp
+
+#include <iostream>
+#include <string>
+
+#include "bench_helper.cpp"
+#include "diameter.cpp"
+
+// Prints the diameter as found each way, and returns false if they disagree.
+bool measure(const std::string& name, const weighted_graph<int>& g, path_length length){
+
+	csr_graph<int> c(g);
+	traversal_workspace ws(c.num_vertices());
+	int expected = 0;
+	double every = time_ms([&]{
+		for (int u = 0; u < c.num_vertices(); ++u){
+			distance_search(c, u, length, ws);
+			expected = std::max(expected, ws.distance(ws.frontier.back()));
+		}
+	});
+	std::cout << name << ": " << every << " ms for " << c.num_vertices() << " searches, diameter " << expected << std::endl;
+	
+	std::vector<component_diameter<int>> diameters;
+	eccentricity_report<int> report;
+	double ifub = time_ms([&]{ diameters = component_diameters(g, length); });
+	double bounded = time_ms([&]{ report = eccentricities(g, length); });
+	std::cout << "  iFUB: " << ifub << " ms for " << diameters[0].searches << " searches, diameter " << diameters[0].diameter << std::endl;
+	std::cout << "  eccentricities: " << bounded << " ms for " << report.searches << " searches, diameter " << report.diameter[0] << std::endl;
+	return diameters[0].diameter == expected && report.diameter[0] == expected;
+
+}
+
+int main(){
+
+	auto grid = random_grid_graph(100, 100, 10, 42);
+	auto random = random_connected_graph(10000, 10000, 10, 42);
+	
+	bool match = true;
+	match &= measure("grid, weighted", grid, path_length::weighted);
+	match &= measure("grid, hops", grid, path_length::hops);
+	match &= measure("random, weighted", random, path_length::weighted);
+	match &= measure("random, hops", random, path_length::hops);
+	
+	std::cout << (match ? "diameters match" : "diameter mismatch") << std::endl;
+	return !match;
+
+}
@@ -0,0 +1,58 @@
+// Measures a 256-source distance matrix built one search at a time into a map per source, as
+// calling dijkstras in a loop does, against distance_matrix_ids filling one array on a thread pool,
+// and against the same with only 64 targets, where each search stops once it has settled them.
+// Build from this directory with: g++ -std=c++17 -O2 -pthread -I.. distance_matrix_benchmark.cpp
+
+#include <iostream>
+#include <map>
+#include <thread>
+
+#include "bench_helper.cpp"
+#include "distance_matrix.cpp"
+
+int main(){
+
+	const int rows = 300;
+	const int sources_count = 256;
+	
+	auto g = random_grid_graph(rows, rows, 10, 42);
+	csr_graph<int> c(g);
+	const int n = c.num_vertices();
+	std::cout << "graph: " << g.num_vertices() << " vertices, " << g.num_edges() << " edges" << std::endl;
+	
+	std::vector<int> sources;
+	for (int i = 0; i < sources_count; ++i) sources.push_back(i * (n / sources_count));
+	
+	traversal_workspace ws(n);
+	std::vector<std::map<int, int>> maps(sources_count);
+	double one_at_a_time = time_ms([&]{
+		for (int i = 0; i < sources_count; ++i){
+			dijkstras(c, sources[i], ws);
+			for (int u = 0; u < n; ++u) maps[i][u] = ws.distance(u);
+		}
+	});
+	std::cout << sources_count << " x dijkstras into maps: " << one_at_a_time << " ms" << std::endl;
+	
+	unsigned threads = std::max(1u, std::thread::hardware_concurrency());
+	thread_pool pool(threads);
+	std::vector<int> all_targets(n);
+	for (int u = 0; u < n; ++u) all_targets[u] = u;
+	std::vector<int> matrix;
+	double batched = time_ms([&]{ distance_matrix_ids(c, sources, all_targets, pool, matrix); });
+	std::cout << "distance_matrix_ids, all targets, " << threads << " threads: " << batched << " ms" << std::endl;
+	
+	// 64 neighbouring ids along the middle row of the grid
+	std::vector<int> few_targets(all_targets.begin() + n / 2, all_targets.begin() + n / 2 + 64);
+	std::vector<int> few;
+	double subset = time_ms([&]{ distance_matrix_ids(c, sources, few_targets, pool, few); });
+	std::cout << "distance_matrix_ids, 64 targets: " << subset << " ms" << std::endl;
+	
+	bool match = true;
+	for (int i = 0; i < sources_count; ++i){
+		for (int u = 0; u < n; ++u) match = match && matrix[static_cast<long long>(i) * n + u] == maps[i][u];
+		for (int j = 0; j < few_targets.size(); ++j) match = match && few[i * few_targets.size() + j] == maps[i][few_targets[j]];
+	}
+	std::cout << (match ? "results match" : "result mismatch") << std::endl;
+	return !match;
+
+}
@@ -0,0 +1,94 @@
+// Compares fully dynamic connectivity against recomputing from scratch on a stream of
+// mixed edge insertions and deletions, each followed by a connectivity query.
+// Build from this directory with: g++ -std=c++17 -O2 -I.. dynamic_connectivity_benchmark.cpp
+
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "bench_helper.cpp"
+#include "graph_algorithms.cpp"
+#include "dynamic_connectivity.hpp"
+
+// Applies updates random insertions or deletions to g, asking is-connected(u, v) after each one.
+// Returns how many of the queries found a path.
+template <typename F>
+int run_workload(weighted_graph<int>& g, int n, int updates, unsigned seed, F connected){
+
+	std::mt19937 rng(seed);
+	std::uniform_int_distribution<int> any(0, n - 1);
+	std::vector<std::pair<int, int>> edges;
+	for (auto u : g){
+		for (auto n_it = g.neighbours_begin(u); n_it != g.neighbours_end(u); ++n_it){
+			if (u < n_it->first) edges.push_back({u, n_it->first});
+		}
+	}
+	
+	int found = 0;
+	for (int i = 0; i < updates; ++i){
+		if (rng()%2 && !edges.empty()){
+			int index = rng()%edges.size();
+			g.remove_edge(edges[index].first, edges[index].second);
+			edges[index] = edges.back();
+			edges.pop_back();
+		}
+		else {
+			int u = any(rng);
+			int v = any(rng);
+			if (u != v && !g.are_adjacent(u, v)){
+				g.add_edge(u, v, 1);
+				edges.push_back({u, v});
+			}
+		}
+		if (connected(any(rng), any(rng))) ++found;
+	}
+	return found;
+
+}
+
+int main(){
+
+	const int n = 20000;
+	const int edges = 12000; // sparse enough that deletions keep splitting and merging components
+	const int updates = 100000;
+	const int scratch_updates = 200;
+	
+	auto base = random_connected_graph(n, 0, 1, 42);
+	// Start from a forest rather than a tree, by dropping random tree edges
+	std::mt19937 rng(1);
+	while (base.num_edges() > edges){
+		int u = rng()%n;
+		if (base.degree(u) > 0) base.remove_edge(u, base.neighbours_begin(u)->first);
+	}
+	std::cout << "graph: " << base.num_vertices() << " vertices, " << base.num_edges() << " edges" << std::endl;
+	
+	auto g = base;
+	dynamic_connectivity<int>* dynamic = nullptr;
+	double build = time_ms([&]{ dynamic = new dynamic_connectivity<int>(g); });
+	int dynamic_found = 0;
+	double dynamic_total = time_ms([&]{
+		dynamic_found = run_workload(g, n, updates, 7, [&](int u, int v){ return dynamic->connected(u, v); });
+	});
+	delete dynamic;
+	
+	auto h = base;
+	int scratch_found = 0;
+	double scratch_total = time_ms([&]{
+		scratch_found = run_workload(h, n, scratch_updates, 7, [&](int u, int v){
+			auto labelling = component_labels(h);
+			return labelling.component.at(u) == labelling.component.at(v);
+		});
+	});
+	
+	// The first scratch_updates operations are identical, so the runs must agree on them
+	auto check = base;
+	dynamic_connectivity<int> replay(check);
+	int replay_found = run_workload(check, n, scratch_updates, 7, [&](int u, int v){ return replay.connected(u, v); });
+	
+	std::cout << "dynamic connectivity: build " << build << " ms, " << dynamic_total*1000/updates << " us per update + query ("
+	          << dynamic_found << " connected)" << std::endl;
+	std::cout << "recompute from scratch: " << scratch_total*1000/scratch_updates << " us per update + query" << std::endl;
+	std::cout << (replay_found == scratch_found ? "answers match" : "answers differ") << std::endl;
+	return replay_found != scratch_found;
+
+}
@@ -0,0 +1,65 @@
+// Measures repairing the distances from a few fixed sources after single edge changes on a
+// road-like grid, against running a heap-based Dijkstra's from every source after each change.
+// Build from this directory with: g++ -std=c++17 -O2 -pthread -I.. dynamic_shortest_paths_benchmark.cpp
+
+#include <iostream>
+#include <random>
+
+#include "bench_helper.cpp"
+#include "graph_algorithms.cpp"
+#include "dynamic_shortest_paths.hpp"
+
+int main(){
+
+	const int rows = 300;
+	const int updates = 2000;
+	const std::vector<int> sources = {0, rows*rows/2 + rows/2, rows*rows - 1, 1234};
+	
+	auto g = random_grid_graph(rows, rows, 10, 42);
+	std::cout << "graph: " << g.num_vertices() << " vertices, " << g.num_edges() << " edges, " << sources.size() << " sources" << std::endl;
+	
+	dynamic_shortest_paths<int>* paths = nullptr;
+	double loading = time_ms([&]{ paths = new dynamic_shortest_paths<int>(g, sources); });
+	std::cout << "initial searches: " << loading << " ms" << std::endl;
+	
+	// Random changes to grid edges: reweighting, removing, and putting back removed ones
+	std::mt19937 rng(7);
+	std::vector<std::pair<int, int>> removed;
+	long long touched = 0;
+	double repairing = time_ms([&]{
+		for (int i = 0; i < updates; ++i){
+			int change = rng()%4;
+			if (change == 3 && !removed.empty()){
+				g.add_edge(removed.back().first, removed.back().second, rng()%10 + 1);
+				removed.pop_back();
+			} else {
+				int u = rng()%(rows*rows);
+				int v = (u % rows + 1 < rows) ? u + 1 : u - 1;
+				if (!g.are_adjacent(u, v)) continue;
+				if (change == 2){
+					g.remove_edge(u, v);
+					removed.push_back({u, v});
+				} else {
+					g.set_edge_weight(u, v, rng()%10 + 1);
+				}
+			}
+			touched += paths->last_touched();
+		}
+	});
+	std::cout << "repairs: " << repairing * 1000 / updates << " us per update, " << double(touched) / updates << " vertices touched on average" << std::endl;
+	
+	csr_graph<int> c(g);
+	traversal_workspace ws(c.num_vertices());
+	bool mismatch = false;
+	double recomputing = 0;
+	for (auto s : sources){
+		recomputing += time_ms([&]{ dijkstras(c, s, ws); });
+		for (int u = 0; u < c.num_vertices(); ++u) if (ws.distance(u) != paths->distance(s, c.vertex_at(u))) mismatch = true;
+	}
+	std::cout << "recomputing from every source: " << recomputing << " ms per update" << std::endl;
+	delete paths;
+	
+	std::cout << (mismatch ? "distance mismatch" : "distances match") << std::endl;
+	return mismatch;
+
+}
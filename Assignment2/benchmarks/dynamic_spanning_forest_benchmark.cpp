@@ -0,0 +1,93 @@
+// Compares the dynamic minimum spanning forest against rebuilding it with Filter-Kruskal after
+// every change, on a stream of weight changes, insertions and deletions.
+// Build from this directory with: g++ -std=c++17 -O2 -pthread -I.. dynamic_spanning_forest_benchmark.cpp
+
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "bench_helper.cpp"
+#include "minimum_spanning_forest.cpp"
+#include "dynamic_spanning_forest.hpp"
+
+// Applies updates random changes to g, reading the forest's total weight after each one.
+// Returns the sum of the weights read.
+template <typename F>
+long long run_workload(weighted_graph<int>& g, int n, int updates, unsigned seed, F weight){
+
+	std::mt19937 rng(seed);
+	std::uniform_int_distribution<int> any(0, n - 1);
+	std::vector<std::pair<int, int>> edges;
+	for (auto u : g){
+		for (auto n_it = g.neighbours_begin(u); n_it != g.neighbours_end(u); ++n_it){
+			if (u < n_it->first) edges.push_back({u, n_it->first});
+		}
+	}
+	
+	long long total = 0;
+	for (int i = 0; i < updates; ++i){
+		int op = rng()%4;
+		if (op < 2 && !edges.empty()){
+			auto e = edges[rng()%edges.size()];
+			g.set_edge_weight(e.first, e.second, rng()%1000 + 1);
+		}
+		else if (op == 2 && !edges.empty()){
+			int index = rng()%edges.size();
+			g.remove_edge(edges[index].first, edges[index].second);
+			edges[index] = edges.back();
+			edges.pop_back();
+		}
+		else {
+			int u = any(rng);
+			int v = any(rng);
+			if (u != v && !g.are_adjacent(u, v)){
+				g.add_edge(u, v, rng()%1000 + 1);
+				edges.push_back({u, v});
+			}
+		}
+		total += weight();
+	}
+	return total;
+
+}
+
+int main(){
+
+	const int n = 20000;
+	const int updates = 100000;
+	const int scratch_updates = 100;
+	
+	auto base = random_connected_graph(n, 3*n, 1000, 42);
+	std::cout << "graph: " << base.num_vertices() << " vertices, " << base.num_edges() << " edges" << std::endl;
+	
+	auto g = base;
+	dynamic_spanning_forest<int>* dynamic = nullptr;
+	double build = time_ms([&]{ dynamic = new dynamic_spanning_forest<int>(g); });
+	long long dynamic_check = 0;
+	double dynamic_total = time_ms([&]{
+		dynamic_check = run_workload(g, n, scratch_updates, 7, [&]{ return dynamic->total_weight(); });
+		run_workload(g, n, updates - scratch_updates, 8, [&]{ return dynamic->total_weight(); });
+	});
+	delete dynamic;
+	
+	auto h = base;
+	thread_pool pool(1);
+	long long scratch_check = 0;
+	double scratch_total = time_ms([&]{
+		scratch_check = run_workload(h, n, scratch_updates, 7, [&]{
+			long long total = 0;
+			for (auto& e : minimum_spanning_forest_edges(h, pool)) total += e.weight;
+			return total;
+		});
+	});
+	
+	std::cout << "dynamic: built in " << build << " ms, " << updates << " updates in " << dynamic_total << " ms ("
+	          << dynamic_total * 1000 / updates << " us each)" << std::endl;
+	std::cout << "rebuilt: " << scratch_updates << " updates in " << scratch_total << " ms ("
+	          << scratch_total * 1000 / scratch_updates << " us each)" << std::endl;
+	
+	bool mismatch = dynamic_check != scratch_check;
+	std::cout << (mismatch ? "weight mismatch" : "weights match over the first " + std::to_string(scratch_updates) + " updates") << std::endl;
+	return mismatch;
+
+}
@@ -0,0 +1,51 @@
+// Measures Jones-Plassmann and speculative coloring from 1 to 64 threads under both orderings,
+// against the sequential greedy coloring in the same order: colors used, rounds and time.
+// Build from this directory with: g++ -std=c++17 -O2 -pthread -I.. graph_coloring_benchmark.cpp
+
+#include <iostream>
+#include <string>
+
+#include "bench_helper.cpp"
+#include "graph_coloring.cpp"
+
+// Returns the number of colors used.
+int colors_used(const std::vector<int>& color){
+	int colors = 0;
+	for (auto k : color) colors = std::max(colors, k + 1);
+	return colors;
+}
+
+int main(){
+
+	const int n = 200000;
+	const int extra_edges = 2000000;
+	
+	auto g = random_connected_graph(n, extra_edges, 1, 42);
+	csr_graph<int> c(g);
+	std::cout << "graph: " << g.num_vertices() << " vertices, " << g.num_edges() << " edges, largest degree " << max_degree(c) << std::endl;
+	
+	bool mismatch = false;
+	for (auto order : {coloring_order::largest_degree_first, coloring_order::smallest_last}){
+		std::string name = order == coloring_order::largest_degree_first ? "largest degree first" : "smallest last";
+		std::vector<int> priority;
+		double ordering = time_ms([&]{ priority = coloring_priorities(c, order, 7); });
+		std::vector<int> greedy;
+		double sequential = time_ms([&]{ greedy = greedy_coloring_ids(c, priority); });
+		std::cout << name << ": " << ordering << " ms to order, greedy " << sequential << " ms, " << colors_used(greedy) << " colors" << std::endl;
+		
+		for (int threads = 1; threads <= 64; threads *= 2){
+			thread_pool pool(threads);
+			std::vector<int> jp, speculative;
+			int jp_rounds = 0, speculative_rounds = 0;
+			double jp_time = time_ms([&]{ jp = jones_plassmann_ids(c, priority, pool, jp_rounds); });
+			double speculative_time = time_ms([&]{ speculative = speculative_coloring_ids(c, priority, pool, speculative_rounds); });
+			if (jp != greedy || !is_proper_coloring(c, speculative)) mismatch = true;
+			std::cout << "  " << threads << " threads: Jones-Plassmann " << jp_time << " ms, " << colors_used(jp) << " colors in " << jp_rounds << " rounds; "
+				<< "speculative " << speculative_time << " ms, " << colors_used(speculative) << " colors in " << speculative_rounds << " rounds" << std::endl;
+		}
+	}
+	
+	std::cout << (mismatch ? "coloring mismatch" : "colorings match") << std::endl;
+	return mismatch;
+
+}
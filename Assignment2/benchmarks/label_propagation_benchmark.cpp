@@ -0,0 +1,58 @@
+// Measures weighted label propagation from 1 to 64 threads on a planted partition graph: blocks of
+// densely connected vertices with a few light edges between them. Reports the time per million
+// edges, the modularity found and the modularity of the planted blocks themselves.
+// Build from this directory with: g++ -std=c++17 -O2 -pthread -I.. label_propagation_benchmark.cpp
+
+#include <iostream>
+#include <random>
+#include <unordered_map>
+
+#include "bench_helper.cpp"
+#include "label_propagation.cpp"
+
+int main(){
+
+	const int n = 200000;
+	const int block = 50;
+	const int inside = 8; // edges from each vertex into its own block
+	const int across = 2; // and out of it
+	
+	std::mt19937 rng(42);
+	weighted_graph<int> g;
+	for (int i = 0; i < n; ++i) g.add_vertex(i);
+	std::unordered_map<int, int> planted;
+	for (int u = 0; u < n; ++u){
+		planted[u] = u / block;
+		for (int i = 0; i < inside; ++i){
+			int v = (u / block) * block + rng()%block;
+			if (u != v && !g.are_adjacent(u, v)) g.add_edge(u, v, rng()%10 + 1);
+		}
+		for (int i = 0; i < across; ++i){
+			int v = rng()%n;
+			if (u != v && !g.are_adjacent(u, v)) g.add_edge(u, v, rng()%3 + 1);
+		}
+	}
+	std::cout << "graph: " << g.num_vertices() << " vertices, " << g.num_edges() << " edges, planted modularity " << modularity(g, planted) << std::endl;
+	
+	csr_graph<int> c(g);
+	label_propagation_options options;
+	options.seed = 7;
+	bool poor = false;
+	for (int threads = 1; threads <= 64; threads *= 2){
+		thread_pool pool(threads);
+		std::vector<int> label;
+		int rounds = 0;
+		double propagation = time_ms([&]{ rounds = label_propagation_ids(c, pool, options, label); });
+		community_partition<int> partition;
+		double whole = time_ms([&]{ partition = label_propagation(g, pool, options); });
+		double q = modularity(g, partition.community);
+		if (q < 0.5) poor = true;
+		std::cout << threads << " threads: " << propagation << " ms over " << rounds << " rounds ("
+			<< propagation / (c.num_edges() / 1e6) << " ms per million edges), "
+			<< whole << " ms from the graph, " << partition.sizes.size() << " communities, modularity " << q << std::endl;
+	}
+	
+	std::cout << (poor ? "communities missed" : "communities found") << std::endl;
+	return poor;
+
+}
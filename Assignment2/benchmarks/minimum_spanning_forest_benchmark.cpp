@@ -0,0 +1,45 @@
+// Measures Filter-Kruskal against Prim's algorithm on a sparse grid and on a dense random graph,
+// with Filter-Kruskal's sorts spread over 1 to 64 threads.
+// Build from this directory with: g++ -std=c++17 -O2 -pthread -I.. minimum_spanning_forest_benchmark.cpp
+
+#include <iostream>
+#include <vector>
+#include <string>
+
+#include "bench_helper.cpp"
+#include "minimum_spanning_forest.cpp"
+
+long long total(const std::vector<id_edge>& forest){
+	long long weight = 0;
+	for (auto& e : forest) weight += e.weight;
+	return weight;
+}
+
+bool run(const std::string& name, const weighted_graph<int>& g){
+	csr_graph<int> c(g);
+	std::cout << name << ": " << g.num_vertices() << " vertices, " << g.num_edges() << " edges" << std::endl;
+	
+	std::vector<id_edge> expected;
+	double prim = time_ms([&]{ expected = prim_spanning_forest_ids(c); });
+	std::cout << "  prim: " << prim << " ms, weight " << total(expected) << std::endl;
+	
+	bool mismatch = false;
+	for (int threads = 1; threads <= 64; threads *= 2){
+		thread_pool pool(threads);
+		std::vector<id_edge> forest;
+		double filter = time_ms([&]{ forest = minimum_spanning_forest_ids(c, pool); });
+		if (total(forest) != total(expected) || forest.size() != expected.size()) mismatch = true;
+		std::cout << "  filter-kruskal, " << threads << " threads: " << filter << " ms" << std::endl;
+	}
+	return mismatch;
+}
+
+int main(){
+
+	bool mismatch = run("sparse grid", random_grid_graph(700, 700, 1000, 42));
+	mismatch |= run("dense random", random_connected_graph(20000, 4000000, 1000, 42));
+	
+	std::cout << (mismatch ? "weight mismatch" : "weights match") << std::endl;
+	return mismatch;
+
+}
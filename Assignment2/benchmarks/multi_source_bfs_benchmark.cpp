@@ -0,0 +1,42 @@
+// Measures 256 breadth first searches run one at a time against MS-BFS batches of 64 and 256 sources.
+// Build from this directory with: g++ -std=c++17 -O2 -march=native -I.. multi_source_bfs_benchmark.cpp
+
+#include <iostream>
+#include <vector>
+
+#include "bench_helper.cpp"
+#include "multi_source_bfs.cpp"
+#include "easy_weighted_graph_algorithms.cpp"
+
+int main(){
+
+	const int n = 200000;
+	const int extra_edges = 600000;
+	
+	auto g = random_connected_graph(n, extra_edges, 10, 42);
+	csr_graph<int> c(g);
+	std::cout << "graph: " << g.num_vertices() << " vertices, " << g.num_edges() << " edges" << std::endl;
+	
+	std::vector<int> sources;
+	for (int i = 0; i < 256; ++i) sources.push_back(i * (n / 256));
+	
+	long long reached = 0;
+	double separate = time_ms([&]{
+		for (int s : sources) reached += breadth_first(c, s).size();
+	});
+	std::cout << "256 x breadth_first: " << separate << " ms" << std::endl;
+	
+	std::vector<bfs_summary> narrow, wide;
+	double batches_of_64 = time_ms([&]{ narrow = multi_source_summaries<1>(c, sources); });
+	double batches_of_256 = time_ms([&]{ wide = multi_source_summaries<4>(c, sources); });
+	std::cout << "MS-BFS, 64 sources a batch: " << batches_of_64 << " ms" << std::endl;
+	std::cout << "MS-BFS, 256 sources a batch: " << batches_of_256 << " ms" << std::endl;
+	
+	long long narrow_reached = 0, wide_reached = 0;
+	for (auto& s : narrow) narrow_reached += s.reached;
+	for (auto& s : wide) wide_reached += s.reached;
+	bool mismatch = narrow_reached != reached || wide_reached != reached;
+	std::cout << (mismatch ? "reach mismatch" : "reach matches") << std::endl;
+	return mismatch;
+
+}
@@ -0,0 +1,40 @@
+// Measures how the work-stealing breadth first search scales from 1 to 64 threads,
+// against the single-threaded breadth_first over the same frozen graph.
+// Build from this directory with: g++ -std=c++17 -O2 -pthread -I.. parallel_bfs_benchmark.cpp
+
+#include <iostream>
+#include <vector>
+
+#include "bench_helper.cpp"
+#include "parallel_bfs.cpp"
+#include "easy_weighted_graph_algorithms.cpp"
+
+int main(){
+
+	const int n = 1000000;
+	const int extra_edges = 4000000;
+	
+	auto g = random_connected_graph(n, extra_edges, 10, 42);
+	csr_graph<int> c(g);
+	std::cout << "graph: " << g.num_vertices() << " vertices, " << g.num_edges() << " edges" << std::endl;
+	
+	std::vector<int> bf_order;
+	double sequential = time_ms([&]{ bf_order = breadth_first(c, 0); });
+	std::cout << "breadth_first: " << sequential << " ms, " << bf_order.size() << " vertices reached" << std::endl;
+	
+	bool mismatch = false;
+	for (int threads = 1; threads <= 64; threads *= 2){
+		thread_pool pool(threads);
+		bfs_tree tree;
+		double parallel = time_ms([&]{ tree = parallel_breadth_first(c, 0, pool); });
+		// The order breadth_first visits in must never go back a level
+		for (int i = 1; i < bf_order.size(); ++i){
+			if (tree.level[c.index_of(bf_order[i])] < tree.level[c.index_of(bf_order[i - 1])]) mismatch = true;
+		}
+		std::cout << threads << " threads: " << parallel << " ms" << std::endl;
+	}
+	
+	std::cout << (mismatch ? "level mismatch" : "levels match") << std::endl;
+	return mismatch;
+
+}
@@ -0,0 +1,77 @@
+// Measures weighted random walks drawn from alias tables over the frozen graph, first order and
+// node2vec, from 1 to 64 threads, against stepping along the graph's own neighbour maps with a
+// linear scan of the weights at every step.
+// Build from this directory with: g++ -std=c++17 -O2 -pthread -I.. random_walks_benchmark.cpp
+
+#include <iostream>
+#include <random>
+
+#include "bench_helper.cpp"
+#include "random_walks.cpp"
+
+int main(){
+
+	const int n = 200000;
+	const int extra_edges = 2000000;
+	
+	auto g = random_connected_graph(n, extra_edges, 10, 42);
+	std::cout << "graph: " << g.num_vertices() << " vertices, " << g.num_edges() << " edges" << std::endl;
+	
+	walk_options options;
+	options.length = 80;
+	options.walks_per_vertex = 2;
+	
+	// One walk from every vertex, picking each step by a scan of the neighbour map's weights
+	std::mt19937 rng(1);
+	long long scanned = 0;
+	double scanning = time_ms([&]{
+		for (auto start : g){
+			int current = start;
+			for (int step = 1; step < options.length; ++step){
+				int total = 0;
+				for (auto n_it = g.neighbours_begin(current); n_it != g.neighbours_end(current); ++n_it) total += n_it->second;
+				int pick = rng()%total;
+				for (auto n_it = g.neighbours_begin(current); n_it != g.neighbours_end(current); ++n_it){
+					if ((pick -= n_it->second) < 0){
+						current = n_it->first;
+						break;
+					}
+				}
+				++scanned;
+			}
+		}
+	});
+	std::cout << "neighbour map scans: " << scanned / scanning / 1000 << " million steps per second" << std::endl;
+	
+	csr_graph<int> c(g);
+	thread_pool setup(1);
+	double building = time_ms([&]{ alias_tables tables(c, setup); });
+	std::cout << "alias tables: " << building << " ms to build" << std::endl;
+	
+	bool mismatch = false;
+	long long expected = -1;
+	for (int threads = 1; threads <= 64; threads *= 2){
+		thread_pool pool(threads);
+		alias_tables tables(c, pool);
+		long long checksum = 0, steps = 0, second_steps = 0;
+		double first = time_ms([&]{
+			steps = random_walks_ids(c, tables, options, pool, [&](const walk_batch& batch){
+				for (auto s : batch.steps) checksum += s;
+			});
+		});
+		walk_options node2vec = options;
+		node2vec.p = 0.5;
+		node2vec.q = 2;
+		double second = time_ms([&]{
+			second_steps = random_walks_ids(c, tables, node2vec, pool, [](const walk_batch&){});
+		});
+		if (expected == -1) expected = checksum;
+		if (checksum != expected) mismatch = true;
+		std::cout << threads << " threads: " << steps / first / 1000 << " million steps per second first order, "
+			<< second_steps / second / 1000 << " node2vec" << std::endl;
+	}
+	
+	std::cout << (mismatch ? "walk mismatch" : "walks match") << std::endl;
+	return mismatch;
+
+}
@@ -0,0 +1,122 @@
+#ifndef BETWEENNESS
+#define BETWEENNESS
+
+#include <cmath>
+#include <random>
+#include <vector>
+#include <numeric>
+#include <algorithm>
+#include <unordered_map>
+#include "weighted_graph.hpp"
+#include "csr_graph.hpp"
+#include "thread_pool.hpp"
+#include "traversal_workspace.hpp"
+#include "graph_algorithms.cpp"
+
+// Returns, for every id of c, the sum over the given source ids s of the dependency of s on it: the
+// fraction of shortest paths from s to each other vertex that pass through it (Brandes).
+// Sources are spread over the pool. Each worker keeps its own workspace, path counts, dependencies
+// and running totals, and the totals are only added together at the end, so the workers never write
+// to shared memory. Each source is one run of shortest_path_ids, after which the path counts are
+// filled in in order of increasing distance and the dependencies in order of decreasing distance.
+// A neighbour u is a predecessor of v exactly when distance(u) + weight(u, v) == distance(v), so no
+// predecessor lists are kept. Edge weights must be positive.
+template <typename vertex>
+std::vector<double> dependency_sums(const csr_graph<vertex>& c, const std::vector<int>& sources, thread_pool& pool) {
+	const int n = c.num_vertices();
+	std::vector<traversal_workspace> workspaces(pool.size());
+	std::vector<std::vector<double>> paths(pool.size(), std::vector<double>(n));
+	std::vector<std::vector<double>> dependency(pool.size(), std::vector<double>(n));
+	std::vector<std::vector<double>> totals(pool.size(), std::vector<double>(n, 0));
+
+	pool.parallel_for(0, sources.size(), 1, [&](int begin, int end, int worker) {
+		traversal_workspace& ws = workspaces[worker];
+		std::vector<double>& sigma = paths[worker];
+		std::vector<double>& delta = dependency[worker];
+		std::vector<double>& total = totals[worker];
+		for (int i = begin; i < end; ++i) {
+			int s = sources[i];
+			shortest_path_ids(c, s, ws);
+			const std::vector<int>& settled = ws.frontier;
+			if (settled.empty()) continue;
+
+			sigma[s] = 1;
+			for (int k = 1; k < settled.size(); ++k) {
+				int v = settled[k];
+				sigma[v] = 0;
+				auto w = c.weights_begin(v);
+				for (auto n_it = c.neighbours_begin(v); n_it != c.neighbours_end(v); ++n_it, ++w) {
+					if (ws.settled(*n_it) && ws.distance(*n_it) + *w == ws.distance(v)) sigma[v] += sigma[*n_it];
+				}
+			}
+
+			for (int v : settled) delta[v] = 0;
+			for (int k = settled.size() - 1; k > 0; --k) {
+				int v = settled[k];
+				double share = (1 + delta[v]) / sigma[v];
+				auto w = c.weights_begin(v);
+				for (auto n_it = c.neighbours_begin(v); n_it != c.neighbours_end(v); ++n_it, ++w) {
+					if (ws.settled(*n_it) && ws.distance(*n_it) + *w == ws.distance(v)) delta[*n_it] += sigma[*n_it] * share;
+				}
+				total[v] += delta[v];
+			}
+		}
+	});
+
+	std::vector<double> sums(n, 0);
+	pool.parallel_for(0, n, 4096, [&](int begin, int end, int) {
+		for (int u = begin; u < end; ++u) {
+			for (auto& total : totals) sums[u] += total[u];
+		}
+	});
+	return sums;
+}
+
+template <typename vertex>
+std::unordered_map<vertex, double> by_vertex(const csr_graph<vertex>& c, const std::vector<double>& values, double scale) {
+	std::unordered_map<vertex, double> result;
+	result.reserve(c.num_vertices());
+	for (int u = 0; u < c.num_vertices(); ++u) result[c.vertex_at(u)] = values[u] * scale;
+	return result;
+}
+
+// Returns the betweenness centrality of every vertex of g: the sum, over every pair of other
+// vertices, of the fraction of the shortest paths between them that pass through it.
+template <typename vertex>
+std::unordered_map<vertex, double> betweenness_centrality(const weighted_graph<vertex>& g, thread_pool& pool) {
+	csr_graph<vertex> c(g);
+	std::vector<int> sources(c.num_vertices());
+	std::iota(sources.begin(), sources.end(), 0);
+	// Every unordered pair was counted once from each end
+	return by_vertex(c, dependency_sums(c, sources, pool), 0.5);
+}
+
+// Returns how many sources approximate_betweenness_centrality samples for a graph of n vertices.
+// A source's dependency on a vertex, divided by n - 2, lies in [0, 1], so by Hoeffding's inequality
+// and a union bound over the n vertices, the mean over this many uniformly drawn sources is within
+// epsilon of its expectation for every vertex at once, with probability at least 1 - delta.
+inline int betweenness_sample_size(int n, double epsilon, double delta) {
+	return std::ceil(std::log(2.0 * n / delta) / (2 * epsilon * epsilon));
+}
+
+// Estimates the betweenness centrality of every vertex of g from a uniform sample of sources, scaled
+// up to the whole graph. Each estimate is n / 2 times the mean dependency over the sample, so with
+// probability at least 1 - delta, every estimate is within epsilon * n * (n - 2) / 2 of the exact
+// value, that is, within epsilon * n / (n - 1) once both are normalised by the (n - 1) * (n - 2) / 2
+// pairs. If the sample would be as large as the graph, the exact values are returned.
+template <typename vertex>
+std::unordered_map<vertex, double> approximate_betweenness_centrality(const weighted_graph<vertex>& g, thread_pool& pool,
+	double epsilon, double delta, unsigned seed = 0) {
+	csr_graph<vertex> c(g);
+	const int n = c.num_vertices();
+	if (n < 3 || betweenness_sample_size(n, epsilon, delta) >= n) return betweenness_centrality(g, pool);
+	int k = betweenness_sample_size(n, epsilon, delta);
+	std::mt19937 rng(seed);
+	std::uniform_int_distribution<int> any(0, n - 1);
+	std::vector<int> sources(k);
+	for (int& s : sources) s = any(rng);
+	// Scaled from k sources up to n, then halved as for the exact values
+	return by_vertex(c, dependency_sums(c, sources, pool), 0.5 * n / k);
+}
+
+#endif
@@ -0,0 +1,161 @@
+#ifndef BICONNECTIVITY
+#define BICONNECTIVITY
+
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <functional>
+#include "weighted_graph.hpp"
+#include "csr_graph.hpp"
+
+// A vertex of a block-cut tree. Block vertices hold the vertices of their biconnected
+// component in v; cut vertices hold the single articulation point they stand for.
+// _id numbers the blocks and the cut vertices separately.
+template <typename vertex_t>
+struct bc_vertex{
+	vertex_t v;
+	bool isCut;
+	unsigned _id;
+
+	bc_vertex(vertex_t vertex, bool is_cut, unsigned id) : v(vertex), isCut(is_cut), _id(id){}
+
+	inline bool operator==(const bc_vertex<vertex_t>& other) const {
+	    return other.v == v && _id == other._id && isCut == other.isCut;
+    }
+
+	inline bool operator<(const bc_vertex<vertex_t>& other) const {
+	    return isCut != other.isCut ? isCut < other.isCut : _id < other._id;
+    }
+};
+
+namespace std {
+    template <typename vertex>
+    struct hash<bc_vertex<vertex>> {
+        inline size_t operator()(const bc_vertex<vertex>& x) const {
+            // Blocks and cut vertices are numbered separately, so the id and kind identify a node
+            return std::hash<size_t>()(2*(size_t)x._id + x.isCut);
+        }
+    };
+}
+
+// The result of a biconnectivity decomposition.
+template <typename vertex>
+struct biconnected_decomposition {
+	std::vector<vertex> articulation_points; // in the graph's iteration order
+	std::vector<std::pair<vertex, vertex>> bridges;
+	std::vector<std::vector<vertex>> components; // the vertices of each block, sorted; isolated vertices form their own block
+	weighted_graph<bc_vertex<std::vector<vertex>>> block_cut_tree;
+};
+
+// Builds the block-cut tree from the blocks and a per-id flag marking which vertices are cut vertices.
+template <typename vertex>
+weighted_graph<bc_vertex<std::vector<vertex>>> build_block_cut_tree(const csr_graph<vertex>& c, const std::vector<std::vector<vertex>>& components, const std::vector<bool>& is_cut) {
+	weighted_graph<bc_vertex<std::vector<vertex>>> tree;
+	std::vector<int> cut_index(c.num_vertices(), -1);
+	int cuts = 0;
+	for (int i = 0; i < c.num_vertices(); ++i) {
+		if (is_cut[i]) {
+			cut_index[i] = cuts;
+			tree.add_vertex(bc_vertex<std::vector<vertex>>({c.vertex_at(i)}, true, cuts++));
+		}
+	}
+	for (int b = 0; b < components.size(); ++b) {
+		bc_vertex<std::vector<vertex>> block(components[b], false, b);
+		tree.add_vertex(block);
+		// Each block is joined to every cut vertex it contains
+		for (auto u : components[b]) {
+			int id = c.index_of(u);
+			if (is_cut[id]) tree.add_edge(block, bc_vertex<std::vector<vertex>>({u}, true, cut_index[id]), 1);
+		}
+	}
+	return tree;
+}
+
+// Computes the articulation points, bridges, biconnected components and block-cut tree of g
+// in O(V + E) using the Hopcroft-Tarjan low-link method. The depth first search keeps its own
+// explicit stack, so very deep graphs do not overflow the call stack.
+template <typename vertex>
+biconnected_decomposition<vertex> biconnected_components(const weighted_graph<vertex>& g) {
+	biconnected_decomposition<vertex> result;
+	csr_graph<vertex> c(g);
+	const int n = c.num_vertices();
+
+	std::vector<int> discovery(n, -1); // discovery time of each vertex
+	std::vector<int> low(n, 0); // earliest discovery time reachable from the vertex's subtree using one back edge
+	std::vector<bool> is_cut(n, false);
+	std::vector<int> in_block(n, -1); // last block each vertex was added to, for deduplicating block vertices
+	std::vector<std::pair<int, int>> edge_stack; // tree and back edges not yet assigned to a block
+
+	struct frame { int v; int parent; const int* next; };
+	std::vector<frame> dfs_stack;
+	int time = 0;
+
+	for (int root = 0; root < n; ++root) {
+		if (discovery[root] != -1) continue;
+		discovery[root] = low[root] = time++;
+
+		int root_children = 0;
+		bool has_edges = false;
+		dfs_stack.push_back({root, -1, c.neighbours_begin(root)});
+
+		while (!dfs_stack.empty()) {
+			frame& f = dfs_stack.back();
+			int u = f.v;
+			if (f.next != c.neighbours_end(u)) {
+				int w = *(f.next++);
+				if (w == u) continue; // self loops never separate anything
+				has_edges = true;
+				if (discovery[w] == -1) {
+					// Tree edge: descend into w
+					edge_stack.push_back({u, w});
+					discovery[w] = low[w] = time++;
+					if (u == root) ++root_children;
+					dfs_stack.push_back({w, u, c.neighbours_begin(w)});
+				}
+				else if (w != f.parent && discovery[w] < discovery[u]) {
+					// Back edge to an ancestor
+					edge_stack.push_back({u, w});
+					low[u] = std::min(low[u], discovery[w]);
+				}
+				continue;
+			}
+
+			// Every neighbour of u is done, so pass its low value up to its parent
+			dfs_stack.pop_back();
+			if (dfs_stack.empty()) break;
+			int p = dfs_stack.back().v;
+			low[p] = std::min(low[p], low[u]);
+
+			if (low[u] > discovery[p]) result.bridges.push_back({c.vertex_at(p), c.vertex_at(u)});
+			if (low[u] >= discovery[p]) {
+				// Nothing in u's subtree reaches above p, so p separates it and the edges above (p, u) form a block
+				if (p != root) is_cut[p] = true;
+				int block = result.components.size();
+				result.components.push_back(std::vector<vertex>());
+				std::pair<int, int> e;
+				do {
+					e = edge_stack.back();
+					edge_stack.pop_back();
+					for (int x : {e.first, e.second}) {
+						if (in_block[x] != block) {
+							in_block[x] = block;
+							result.components.back().push_back(c.vertex_at(x));
+						}
+					}
+				} while (e != std::make_pair(p, u));
+				std::sort(result.components.back().begin(), result.components.back().end());
+			}
+		}
+
+		if (root_children >= 2) is_cut[root] = true;
+		if (!has_edges) result.components.push_back({c.vertex_at(root)});
+	}
+
+	for (auto g_it = g.cbegin(); g_it != g.cend(); ++g_it) {
+		if (is_cut[c.index_of(*g_it)]) result.articulation_points.push_back(*g_it);
+	}
+	result.block_cut_tree = build_block_cut_tree(c, result.components, is_cut);
+	return result;
+}
+
+#endif
@@ -0,0 +1,81 @@
+#ifndef CONCURRENT_DISJOINT_SET_H
+#define CONCURRENT_DISJOINT_SET_H
+
+#include <vector>
+#include <atomic>
+#include <utility>
+
+// A lock-free union-find over the ids 0..n-1 that many threads can update at once.
+// Roots are only ever hooked beneath a smaller root with a compare-and-swap, so the parent
+// pointers can never form a cycle, and find compresses paths by halving as it walks.
+// Once every thread has stopped uniting, the root of each set is its smallest id.
+class concurrent_disjoint_set {
+
+	private:
+
+	std::vector<std::atomic<int>> parent;
+
+	public:
+
+	explicit concurrent_disjoint_set(int);
+
+	int size() const;
+	int find(int);
+	bool unite(int, int);
+	bool same_set(int, int);
+	void compress(int);
+	int parent_of(int) const;
+
+};
+
+inline concurrent_disjoint_set::concurrent_disjoint_set(int n) : parent(n) {
+	for (int i = 0; i < n; ++i) parent[i].store(i, std::memory_order_relaxed);
+}
+
+inline int concurrent_disjoint_set::size() const { return parent.size(); }
+
+inline int concurrent_disjoint_set::find(int x) {
+	while (true) {
+		int p = parent[x].load(std::memory_order_relaxed);
+		if (p == x) return x;
+		int grandparent = parent[p].load(std::memory_order_relaxed);
+		// Path halving: losing this race is harmless, another thread has moved x closer to the root already
+		if (p != grandparent) parent[x].compare_exchange_weak(p, grandparent, std::memory_order_relaxed);
+		x = grandparent;
+	}
+}
+
+// Joins the sets holding a and b. Returns true if they were separate.
+inline bool concurrent_disjoint_set::unite(int a, int b) {
+	while (true) {
+		a = find(a);
+		b = find(b);
+		if (a == b) return false;
+		if (a < b) std::swap(a, b);
+		int expected = a;
+		// Only succeeds if a is still a root; otherwise someone hooked it first and we retry from the new roots
+		if (parent[a].compare_exchange_strong(expected, b, std::memory_order_relaxed)) return true;
+	}
+}
+
+inline bool concurrent_disjoint_set::same_set(int a, int b) {
+	while (true) {
+		a = find(a);
+		b = find(b);
+		if (a == b) return true;
+		// a may have been hooked under another root since it was found
+		if (parent[a].load(std::memory_order_relaxed) == a) return false;
+	}
+}
+
+// Points x straight at its root. Safe to run alongside unite, since the swap only happens
+// if x's parent has not changed in the meantime.
+inline void concurrent_disjoint_set::compress(int x) {
+	int p = parent[x].load(std::memory_order_relaxed);
+	int root = find(x);
+	if (p != root) parent[x].compare_exchange_strong(p, root, std::memory_order_relaxed);
+}
+
+inline int concurrent_disjoint_set::parent_of(int x) const { return parent[x].load(std::memory_order_relaxed); }
+
+#endif
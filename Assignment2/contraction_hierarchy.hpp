@@ -0,0 +1,280 @@
+#ifndef CONTRACTION_HIERARCHY_H
+#define CONTRACTION_HIERARCHY_H
+
+#include <vector>
+#include <queue>
+#include <limits>
+#include <utility>
+#include <algorithm>
+#include <functional>
+#include "weighted_graph.hpp"
+#include "csr_graph.hpp"
+
+// A contraction hierarchy over a weighted_graph, for answering many point-to-point
+// distance queries against a graph that rarely changes.
+//
+// Preprocessing contracts the vertices one at a time in order of increasing edge difference
+// (shortcuts added minus edges removed). When a vertex is contracted a witness search checks,
+// for each pair of its remaining neighbours, whether a path avoiding it is at least as short;
+// if not, a shortcut edge is inserted between them. Queries then only ever have to relax edges
+// towards higher ranked vertices, which are stored in a compact upward CSR.
+//
+// The hierarchy is a snapshot: later changes to the source graph are not seen.
+// Queries reuse internal buffers, so a single hierarchy must not be queried from several threads.
+template <typename vertex>
+class contraction_hierarchy {
+
+	using heap_entry = std::pair<int, int>; // (distance, id)
+
+	private:
+
+	csr_graph<vertex> graph; // the original graph, used to map vertices to dense ids
+	std::vector<int> rank; // the order each vertex was contracted in
+	std::vector<int> up_offsets; // upward edges of id i are up_targets[up_offsets[i]] .. up_targets[up_offsets[i+1]-1]
+	std::vector<int> up_targets;
+	std::vector<int> up_weights;
+	int shortcuts{0};
+
+	// Settled-vertex cap on a single witness search. A search that gives up early just adds
+	// a shortcut that may not have been necessary, so this only trades query speed for preprocessing time.
+	int witness_settle_limit{500};
+
+	// Query workspace, cleared in O(1) by bumping the epoch
+	mutable std::vector<int> forward_distance;
+	mutable std::vector<int> backward_distance;
+	mutable std::vector<unsigned> forward_epoch;
+	mutable std::vector<unsigned> backward_epoch;
+	mutable std::vector<heap_entry> forward_heap;
+	mutable std::vector<heap_entry> backward_heap;
+	mutable unsigned epoch{0};
+
+	void build();
+	bool search_step(std::vector<heap_entry>&, std::vector<int>&, std::vector<unsigned>&, const std::vector<int>&, const std::vector<unsigned>&, int&) const;
+
+	public:
+
+	explicit contraction_hierarchy(const weighted_graph<vertex>&);
+
+	int distance(const vertex&, const vertex&) const;
+	int num_shortcuts() const;
+	int num_upward_edges() const;
+
+};
+
+template <typename vertex> contraction_hierarchy<vertex>::contraction_hierarchy(const weighted_graph<vertex>& g) : graph(g) {
+	build();
+	forward_distance.assign(graph.num_vertices(), std::numeric_limits<int>::max());
+	backward_distance.assign(graph.num_vertices(), std::numeric_limits<int>::max());
+	forward_epoch.assign(graph.num_vertices(), 0);
+	backward_epoch.assign(graph.num_vertices(), 0);
+}
+
+template <typename vertex> void contraction_hierarchy<vertex>::build() {
+	const int n = graph.num_vertices();
+	const int infinity = std::numeric_limits<int>::max();
+
+	// The remaining graph, which gains shortcuts and loses vertices as contraction proceeds
+	std::vector<std::vector<std::pair<int, int>>> remaining(n);
+	for (int u = 0; u < n; ++u) {
+		auto weight = graph.weights_begin(u);
+		for (auto n_it = graph.neighbours_begin(u); n_it != graph.neighbours_end(u); ++n_it, ++weight) {
+			if (*n_it != u) remaining[u].push_back({*n_it, *weight});
+		}
+	}
+
+	std::vector<bool> contracted(n, false);
+	std::vector<int> deleted_neighbours(n, 0);
+
+	// Witness search workspace
+	std::vector<int> witness_distance(n, infinity);
+	std::vector<unsigned> witness_epoch(n, 0);
+	unsigned witness_run = 0;
+	std::vector<heap_entry> witness_heap;
+
+	// Runs a Dijkstra search from source that avoids the vertex being contracted, stopping once
+	// every distance below limit is settled or the settle cap is reached.
+	auto witness_search = [&](int source, int avoid, int limit) {
+		++witness_run;
+		witness_heap.clear();
+		witness_distance[source] = 0;
+		witness_epoch[source] = witness_run;
+		witness_heap.push_back({0, source});
+		int settled = 0;
+		while (!witness_heap.empty() && settled < witness_settle_limit) {
+			std::pop_heap(witness_heap.begin(), witness_heap.end(), std::greater<heap_entry>());
+			heap_entry top = witness_heap.back();
+			witness_heap.pop_back();
+			if (top.first > witness_distance[top.second]) continue;
+			if (top.first > limit) break;
+			++settled;
+			for (auto e : remaining[top.second]) {
+				if (e.first == avoid || contracted[e.first]) continue;
+				int d = top.first + e.second;
+				if (witness_epoch[e.first] != witness_run || d < witness_distance[e.first]) {
+					witness_epoch[e.first] = witness_run;
+					witness_distance[e.first] = d;
+					witness_heap.push_back({d, e.first});
+					std::push_heap(witness_heap.begin(), witness_heap.end(), std::greater<heap_entry>());
+				}
+			}
+		}
+	};
+
+	// Finds the shortcuts contracting v would need, adding them to the remaining graph unless simulate is set.
+	// Returns the number of shortcuts.
+	auto contract = [&](int v, bool simulate) {
+		std::vector<std::pair<int, int>> neighbours;
+		for (auto e : remaining[v]) if (!contracted[e.first]) neighbours.push_back(e);
+		int max_out = 0;
+		for (auto e : neighbours) max_out = std::max(max_out, e.second);
+
+		std::vector<std::pair<std::pair<int, int>, int>> added;
+		for (int i = 0; i < neighbours.size(); ++i) {
+			if (i + 1 == neighbours.size()) break;
+			witness_search(neighbours[i].first, v, neighbours[i].second + max_out);
+			for (int j = i + 1; j < neighbours.size(); ++j) {
+				int via = neighbours[i].second + neighbours[j].second;
+				int w = neighbours[j].first;
+				// No witness path at most as long as the path through v, so a shortcut is needed
+				if (witness_epoch[w] != witness_run || witness_distance[w] > via) {
+					added.push_back({{neighbours[i].first, w}, via});
+				}
+			}
+		}
+
+		if (!simulate) {
+			for (auto s : added) {
+				for (int side = 0; side < 2; ++side) {
+					int a = side == 0 ? s.first.first : s.first.second;
+					int b = side == 0 ? s.first.second : s.first.first;
+					bool found = false;
+					for (auto& e : remaining[a]) {
+						if (e.first == b) {
+							e.second = std::min(e.second, s.second);
+							found = true;
+						}
+					}
+					if (!found) remaining[a].push_back({b, s.second});
+				}
+			}
+		}
+		return (int)added.size();
+	};
+
+	auto priority = [&](int v) {
+		int degree = 0;
+		for (auto e : remaining[v]) if (!contracted[e.first]) ++degree;
+		return contract(v, true) - degree + deleted_neighbours[v];
+	};
+
+	std::priority_queue<heap_entry, std::vector<heap_entry>, std::greater<heap_entry>> order;
+	for (int v = 0; v < n; ++v) order.push({priority(v), v});
+
+	rank.assign(n, 0);
+	std::vector<std::vector<std::pair<int, int>>> upward(n);
+	int next_rank = 0;
+
+	while (!order.empty()) {
+		heap_entry top = order.top();
+		order.pop();
+		int v = top.second;
+		if (contracted[v]) continue;
+		// Priorities are updated lazily, so re-evaluate and defer v if it is no longer the minimum
+		int current = priority(v);
+		if (!order.empty() && current > order.top().first) {
+			order.push({current, v});
+			continue;
+		}
+
+		shortcuts += contract(v, false);
+		// Every neighbour still in the graph will be contracted later, so each of these edges points upward
+		for (auto e : remaining[v]) {
+			if (!contracted[e.first]) upward[v].push_back(e);
+		}
+		contracted[v] = true;
+		rank[v] = next_rank++;
+		for (auto e : upward[v]) {
+			++deleted_neighbours[e.first];
+			order.push({priority(e.first), e.first});
+		}
+		std::vector<std::pair<int, int>>().swap(remaining[v]);
+	}
+
+	// Flatten the upward edges into CSR form
+	up_offsets.assign(n + 1, 0);
+	for (int v = 0; v < n; ++v) up_offsets[v + 1] = up_offsets[v] + upward[v].size();
+	up_targets.resize(up_offsets.back());
+	up_weights.resize(up_offsets.back());
+	for (int v = 0; v < n; ++v) {
+		for (int i = 0; i < upward[v].size(); ++i) {
+			up_targets[up_offsets[v] + i] = upward[v][i].first;
+			up_weights[up_offsets[v] + i] = upward[v][i].second;
+		}
+	}
+}
+
+// Settles one vertex of one side of the bidirectional search, updating best if the two searches meet.
+// Returns false once this side can no longer improve on best.
+template <typename vertex> bool contraction_hierarchy<vertex>::search_step(std::vector<heap_entry>& heap, std::vector<int>& distance, std::vector<unsigned>& stamp, const std::vector<int>& other_distance, const std::vector<unsigned>& other_stamp, int& best) const {
+	while (!heap.empty()) {
+		std::pop_heap(heap.begin(), heap.end(), std::greater<heap_entry>());
+		heap_entry top = heap.back();
+		heap.pop_back();
+		int u = top.second;
+		if (top.first > distance[u]) continue;
+		if (top.first >= best) {
+			heap.clear();
+			return false;
+		}
+		if (other_stamp[u] == epoch) best = std::min(best, top.first + other_distance[u]);
+		for (int i = up_offsets[u]; i < up_offsets[u + 1]; ++i) {
+			int v = up_targets[i];
+			int d = top.first + up_weights[i];
+			if (stamp[v] != epoch || d < distance[v]) {
+				stamp[v] = epoch;
+				distance[v] = d;
+				heap.push_back({d, v});
+				std::push_heap(heap.begin(), heap.end(), std::greater<heap_entry>());
+			}
+		}
+		return true;
+	}
+	return false;
+}
+
+// Returns the shortest distance between s and t, or the max int value if t cannot be reached from s.
+template <typename vertex> int contraction_hierarchy<vertex>::distance(const vertex& s, const vertex& t) const {
+	int best = std::numeric_limits<int>::max();
+	if (!graph.has_vertex(s) || !graph.has_vertex(t)) return best;
+	int source = graph.index_of(s);
+	int target = graph.index_of(t);
+
+	if (++epoch == 0) {
+		// The epoch counter wrapped, so old stamps could look current again
+		std::fill(forward_epoch.begin(), forward_epoch.end(), 0);
+		std::fill(backward_epoch.begin(), backward_epoch.end(), 0);
+		epoch = 1;
+	}
+	forward_heap.clear();
+	backward_heap.clear();
+	forward_distance[source] = 0;
+	forward_epoch[source] = epoch;
+	forward_heap.push_back({0, source});
+	backward_distance[target] = 0;
+	backward_epoch[target] = epoch;
+	backward_heap.push_back({0, target});
+
+	// Alternate between the two upward searches; the shortest path meets at its highest ranked vertex
+	bool forward_active = true;
+	bool backward_active = true;
+	while (forward_active || backward_active) {
+		if (forward_active) forward_active = search_step(forward_heap, forward_distance, forward_epoch, backward_distance, backward_epoch, best);
+		if (backward_active) backward_active = search_step(backward_heap, backward_distance, backward_epoch, forward_distance, forward_epoch, best);
+	}
+	return best;
+}
+
+template <typename vertex> int contraction_hierarchy<vertex>::num_shortcuts() const { return shortcuts; }
+template <typename vertex> int contraction_hierarchy<vertex>::num_upward_edges() const { return up_targets.size(); }
+
+#endif
@@ -0,0 +1,163 @@
+#ifndef CORE_DECOMPOSITION
+#define CORE_DECOMPOSITION
+
+#include <vector>
+#include <atomic>
+#include <algorithm>
+#include <unordered_map>
+#include "weighted_graph.hpp"
+#include "csr_graph.hpp"
+#include "thread_pool.hpp"
+
+// The core numbers of a graph: a vertex's core number is the largest k for which it belongs to the
+// k-core, the largest subgraph in which every vertex has degree at least k.
+template <typename vertex>
+struct core_decomposition {
+	std::unordered_map<vertex, int> core; // vertex -> core number
+	std::vector<vertex> order; // the order the vertices were peeled in, lowest core first
+	int degeneracy = 0; // the largest core number
+};
+
+// Writes the core number of every id of c to core, and the order the ids were peeled in to order
+// (Batagelj and Zaversnik). The ids are kept in one array sorted by current degree, with bin[d] the
+// start of the degree d block, so taking the lowest degree vertex is a step along the array and
+// lowering a neighbour's degree swaps it to the front of its block and moves the block boundary.
+// Each edge is looked at twice, so the whole decomposition is O(V + E).
+template <typename vertex>
+void core_number_ids(const csr_graph<vertex>& c, std::vector<int>& core, std::vector<int>& order) {
+	const int n = c.num_vertices();
+	std::vector<int>& degree = core; // degrees are lowered in place until each one is final
+	degree.resize(n);
+	int max_degree = 0;
+	for (int u = 0; u < n; ++u) {
+		degree[u] = c.degree(u);
+		max_degree = std::max(max_degree, degree[u]);
+	}
+
+	// Counting sort by degree
+	std::vector<int> bin(max_degree + 1, 0);
+	for (int u = 0; u < n; ++u) ++bin[degree[u]];
+	for (int d = 0, start = 0; d <= max_degree; ++d) {
+		int count = bin[d];
+		bin[d] = start;
+		start += count;
+	}
+	std::vector<int>& sorted = order;
+	std::vector<int> position(n);
+	sorted.resize(n);
+	for (int u = 0; u < n; ++u) {
+		position[u] = bin[degree[u]]++;
+		sorted[position[u]] = u;
+	}
+	for (int d = max_degree; d > 0; --d) bin[d] = bin[d - 1];
+	bin[0] = 0;
+
+	for (int i = 0; i < n; ++i) {
+		int u = sorted[i];
+		for (auto w = c.neighbours_begin(u); w != c.neighbours_end(u); ++w) {
+			if (degree[*w] <= degree[u]) continue;
+			// Swap w with the first vertex of its block, then shrink the block past it
+			int d = degree[*w];
+			int first = sorted[bin[d]];
+			if (first != *w) {
+				std::swap(sorted[position[*w]], sorted[bin[d]]);
+				std::swap(position[*w], position[first]);
+			}
+			++bin[d];
+			--degree[*w];
+		}
+	}
+}
+
+// Returns the core number of every vertex of g, with the peeling order and the degeneracy.
+template <typename vertex>
+core_decomposition<vertex> core_numbers(const weighted_graph<vertex>& g) {
+	csr_graph<vertex> c(g);
+	std::vector<int> core, order;
+	core_number_ids(c, core, order);
+	core_decomposition<vertex> result;
+	result.core.reserve(c.num_vertices());
+	for (int u : order) {
+		result.core[c.vertex_at(u)] = core[u];
+		result.order.push_back(c.vertex_at(u));
+		result.degeneracy = std::max(result.degeneracy, core[u]);
+	}
+	return result;
+}
+
+// Returns the core number of every id of c, peeling in parallel. For each k in turn, every vertex
+// left with degree at most k is removed at once, and its neighbours' degrees are lowered with atomic
+// decrements; a neighbour whose degree drops to k joins the next batch, picked up by whichever
+// thread made the final decrement. Rounds repeat until no vertex of degree k remains, and then
+// the survivors are compacted before k goes up.
+template <typename vertex>
+std::vector<int> parallel_core_number_ids(const csr_graph<vertex>& c, thread_pool& pool) {
+	const int n = c.num_vertices();
+	const int grain = 1024;
+	std::vector<int> core(n, -1);
+	std::vector<std::atomic<int>> degree(n);
+	pool.parallel_for(0, n, grain, [&](int begin, int end, int) {
+		for (int u = begin; u < end; ++u) degree[u].store(c.degree(u), std::memory_order_relaxed);
+	});
+
+	std::vector<int> remaining(n);
+	for (int u = 0; u < n; ++u) remaining[u] = u;
+	std::vector<std::vector<int>> local(pool.size());
+	std::vector<int> batch;
+	for (int k = 0; !remaining.empty(); ++k) {
+		// Skip straight past values of k that no vertex has
+		int lowest = degree[remaining[0]].load(std::memory_order_relaxed);
+		for (int u : remaining) lowest = std::min(lowest, degree[u].load(std::memory_order_relaxed));
+		k = std::max(k, lowest);
+		for (int u : remaining) if (degree[u].load(std::memory_order_relaxed) <= k) batch.push_back(u);
+		while (!batch.empty()) {
+			pool.parallel_for(0, batch.size(), 64, [&](int begin, int end, int worker) {
+				for (int i = begin; i < end; ++i) {
+					int u = batch[i];
+					core[u] = k;
+					for (auto w = c.neighbours_begin(u); w != c.neighbours_end(u); ++w) {
+						// Vertices already peeled have degree at most k, so only live ones can cross k + 1
+						if (degree[*w].fetch_sub(1, std::memory_order_relaxed) == k + 1) local[worker].push_back(*w);
+					}
+				}
+			});
+			batch.clear();
+			for (auto& l : local) {
+				batch.insert(batch.end(), l.begin(), l.end());
+				l.clear();
+			}
+		}
+		remaining.erase(std::remove_if(remaining.begin(), remaining.end(), [&](int u) { return core[u] != -1; }), remaining.end());
+	}
+	return core;
+}
+
+// Returns the core number of every vertex of g, computed by parallel peeling.
+template <typename vertex>
+std::unordered_map<vertex, int> parallel_core_numbers(const weighted_graph<vertex>& g, thread_pool& pool) {
+	csr_graph<vertex> c(g);
+	std::vector<int> core = parallel_core_number_ids(c, pool);
+	std::unordered_map<vertex, int> result;
+	result.reserve(c.num_vertices());
+	for (int u = 0; u < c.num_vertices(); ++u) result[c.vertex_at(u)] = core[u];
+	return result;
+}
+
+// Returns the k-core of g, given its core numbers: the vertices with core number at least k and the
+// edges between them. Nothing is peeled again, so any number of cores can be taken from one decomposition.
+template <typename vertex>
+weighted_graph<vertex> k_core(const weighted_graph<vertex>& g, const std::unordered_map<vertex, int>& core, int k) {
+	weighted_graph<vertex> result;
+	for (auto g_it = g.cbegin(); g_it != g.cend(); ++g_it) {
+		if (core.at(*g_it) >= k) result.add_vertex(*g_it);
+	}
+	for (auto g_it = g.cbegin(); g_it != g.cend(); ++g_it) {
+		if (core.at(*g_it) < k) continue;
+		for (auto n_it = g.cneighbours_begin(*g_it); n_it != g.cneighbours_end(*g_it); ++n_it) {
+			if (*g_it < n_it->first && core.at(n_it->first) >= k) result.add_edge(*g_it, n_it->first, n_it->second);
+		}
+	}
+	return result;
+}
+
+#endif
@@ -0,0 +1,86 @@
+#ifndef CSR_GRAPH_H
+#define CSR_GRAPH_H
+
+#include <vector>
+#include <algorithm>
+#include <unordered_map>
+#include "weighted_graph.hpp"
+
+// A frozen, read-only snapshot of a weighted_graph stored in compressed sparse row form.
+// Vertices are given dense ids 0..n-1 in ascending vertex order, and every vertex's
+// neighbours are stored contiguously in ascending id order, so the adjacency can be
+// walked without any hashing once the snapshot has been built.
+template <typename vertex>
+class csr_graph {
+
+	private:
+
+	std::vector<vertex> vertices; // id -> vertex
+	std::unordered_map<vertex, int> ids; // vertex -> id
+	std::vector<int> offsets; // neighbours of id i are targets[offsets[i]] .. targets[offsets[i+1]-1]
+	std::vector<int> targets;
+	std::vector<int> weights;
+
+	public:
+
+	csr_graph();
+	explicit csr_graph(const weighted_graph<vertex>&);
+
+	bool has_vertex(const vertex&) const;
+	int index_of(const vertex&) const;
+	const vertex& vertex_at(int) const;
+
+	int degree(int) const;
+	int num_vertices() const;
+	int num_edges() const;
+	int num_arcs() const;
+
+	const int* neighbours_begin(int) const;
+	const int* neighbours_end(int) const;
+	const int* weights_begin(int) const;
+
+};
+
+template <typename vertex> csr_graph<vertex>::csr_graph() : offsets(1, 0) {}
+
+template <typename vertex> csr_graph<vertex>::csr_graph(const weighted_graph<vertex>& g) {
+	// Number the vertices in ascending order so that id order and vertex order agree
+	vertices.assign(g.cbegin(), g.cend());
+	std::sort(vertices.begin(), vertices.end());
+	ids.reserve(vertices.size());
+	for (int i = 0; i < vertices.size(); ++i) ids[vertices[i]] = i;
+
+	// Size every row first so the arc arrays are allocated exactly once
+	offsets.assign(vertices.size() + 1, 0);
+	for (int i = 0; i < vertices.size(); ++i) offsets[i + 1] = offsets[i] + g.degree(vertices[i]);
+	targets.resize(offsets.back());
+	weights.resize(offsets.back());
+
+	std::vector<std::pair<int, int>> row;
+	for (int i = 0; i < vertices.size(); ++i) {
+		row.clear();
+		for (auto n_it = g.cneighbours_begin(vertices[i]); n_it != g.cneighbours_end(vertices[i]); ++n_it) {
+			row.push_back({ids.at(n_it->first), n_it->second});
+		}
+		std::sort(row.begin(), row.end());
+		for (int j = 0; j < row.size(); ++j) {
+			targets[offsets[i] + j] = row[j].first;
+			weights[offsets[i] + j] = row[j].second;
+		}
+	}
+}
+
+template <typename vertex> bool csr_graph<vertex>::has_vertex(const vertex& u) const { return ids.count(u) > 0; }
+template <typename vertex> int csr_graph<vertex>::index_of(const vertex& u) const { return ids.at(u); }
+template <typename vertex> const vertex& csr_graph<vertex>::vertex_at(int i) const { return vertices[i]; }
+
+template <typename vertex> int csr_graph<vertex>::degree(int i) const { return offsets[i + 1] - offsets[i]; }
+template <typename vertex> int csr_graph<vertex>::num_vertices() const { return vertices.size(); }
+template <typename vertex> int csr_graph<vertex>::num_edges() const { return targets.size() / 2; }
+template <typename vertex> int csr_graph<vertex>::num_arcs() const { return targets.size(); }
+
+template <typename vertex> const int* csr_graph<vertex>::neighbours_begin(int i) const { return targets.data() + offsets[i]; }
+template <typename vertex> const int* csr_graph<vertex>::neighbours_end(int i) const { return targets.data() + offsets[i + 1]; }
+template <typename vertex> const int* csr_graph<vertex>::weights_begin(int i) const { return weights.data() + offsets[i]; }
+
+#endif
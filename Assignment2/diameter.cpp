@@ -0,0 +1,182 @@
+#ifndef DIAMETER
+#define DIAMETER
+
+#include <vector>
+#include <limits>
+#include <utility>
+#include <algorithm>
+#include <unordered_map>
+#include "weighted_graph.hpp"
+#include "csr_graph.hpp"
+#include "traversal_workspace.hpp"
+#include "graph_algorithms.cpp"
+
+// How the length of a path is measured: by the sum of its edge weights, or by how many edges it has.
+enum class path_length { weighted, hops };
+
+// Searches from the id source, leaving the distances in ws and the ids reached in ws.frontier in
+// ascending order of distance, so the last of them is as far from source as any.
+template <typename vertex>
+void distance_search(const csr_graph<vertex>& c, int source, path_length length, traversal_workspace& ws) {
+	if (length == path_length::hops) hop_distance_ids(c, source, ws);
+	else shortest_path_ids(c, source, ws);
+}
+
+// The diameter of one connected component: the largest distance between two of its vertices.
+template <typename vertex>
+struct component_diameter {
+	vertex from;
+	vertex to; // a pair of vertices diameter apart
+	int diameter = 0;
+	int searches = 0; // how many single source searches it took
+};
+
+// Returns the diameter of the component of c containing the id start, as a component_diameter of ids
+// (iFUB). The ids of the component are written to members.
+// Every search from an id gives its eccentricity as a lower bound on the diameter, and twice that as
+// an upper bound. A 4-sweep picks a central root: two double sweeps, the second starting from the
+// middle of the longest path found by the first, and the root in the middle of the second's. The ids
+// are then taken in descending distance from the root. Two ids at most d from the root are at most
+// 2d apart, so once the lower bound reaches twice the distance of the next id every remaining pair is
+// accounted for; until then each id gets a search of its own. On most graphs this stops after a
+// handful of searches, where finding every eccentricity would take one per vertex.
+template <typename vertex>
+component_diameter<int> diameter_ids(const csr_graph<vertex>& c, int start, path_length length, traversal_workspace& ws,
+	std::vector<int>& members) {
+	component_diameter<int> best{start, start, 0, 0};
+	int upper = std::numeric_limits<int>::max();
+	auto sweep = [&](int source) {
+		distance_search(c, source, length, ws);
+		++best.searches;
+		int far = ws.frontier.back();
+		if (ws.distance(far) > best.diameter) {
+			best.from = source;
+			best.to = far;
+			best.diameter = ws.distance(far);
+		}
+		upper = std::min(upper, 2 * ws.distance(far));
+		return far;
+	};
+	// The id halfway along the path the last search found to far
+	auto midpoint = [&](int far) {
+		int half = far;
+		while (2 * ws.distance(half) > ws.distance(far)) half = ws.parent(half);
+		return half;
+	};
+
+	int far = sweep(start);
+	members.assign(ws.frontier.begin(), ws.frontier.end());
+	for (int round = 0; round < 2; ++round) {
+		if (best.diameter == upper) return best;
+		far = sweep(far);
+		if (best.diameter == upper) return best;
+		far = sweep(midpoint(far));
+	}
+	if (best.diameter == upper) return best;
+
+	// The last sweep was from the root
+	std::vector<std::pair<int, int>> fringe; // (distance from the root, id), farthest first
+	fringe.reserve(ws.frontier.size());
+	for (auto f_it = ws.frontier.rbegin(); f_it != ws.frontier.rend(); ++f_it) fringe.push_back({ws.distance(*f_it), *f_it});
+	for (const auto& f : fringe) {
+		if (best.diameter >= 2 * f.first || best.diameter == upper) break;
+		sweep(f.second);
+	}
+	return best;
+}
+
+// Returns the diameter of every connected component of g, in the same order as connected_components.
+template <typename vertex>
+std::vector<component_diameter<vertex>> component_diameters(const weighted_graph<vertex>& g, path_length length = path_length::weighted) {
+	csr_graph<vertex> c(g);
+	const int n = c.num_vertices();
+	traversal_workspace ws(n);
+	std::vector<char> done(n, false);
+	std::vector<int> members;
+	std::vector<component_diameter<vertex>> result;
+	// Going by g's own order, so components come up in order of their first vertex as they do there
+	for (auto g_it = g.cbegin(); g_it != g.cend(); ++g_it) {
+		int u = c.index_of(*g_it);
+		if (done[u]) continue;
+		component_diameter<int> d = diameter_ids(c, u, length, ws, members);
+		for (int w : members) done[w] = true;
+		result.push_back({c.vertex_at(d.from), c.vertex_at(d.to), d.diameter, d.searches});
+	}
+	return result;
+}
+
+// Writes the eccentricity of every id in the component of c containing start to eccentricity, and
+// its ids to members, and returns how many searches it took (Takes and Kosters' BoundingDiameters).
+// Every id keeps a lower and an upper bound on its eccentricity. A search from v, of eccentricity e,
+// tightens both for every id w of the component: ecc(w) is at least d(v, w) and e - d(v, w), and at
+// most e + d(v, w). Ids whose bounds meet are resolved without a search of their own. The searches
+// alternate between the unresolved id with the largest upper bound and the one with the smallest
+// lower bound, the higher degree first on ties, as those tend to pin down the most other bounds.
+template <typename vertex>
+int eccentricity_ids(const csr_graph<vertex>& c, int start, path_length length, traversal_workspace& ws,
+	std::vector<int>& eccentricity, std::vector<int>& upper, std::vector<int>& members) {
+	distance_search(c, start, length, ws);
+	members.assign(ws.frontier.begin(), ws.frontier.end());
+	for (int w : members) {
+		eccentricity[w] = 0;
+		upper[w] = std::numeric_limits<int>::max();
+	}
+	std::vector<int> open(members);
+	int searches = 1;
+	for (bool highest = true; ; highest = !highest) {
+		int e = ws.distance(ws.frontier.back());
+		for (int w : open) {
+			int d = ws.distance(w);
+			eccentricity[w] = std::max(eccentricity[w], std::max(d, e - d));
+			upper[w] = std::min(upper[w], e + d);
+		}
+		open.erase(std::remove_if(open.begin(), open.end(), [&](int w) { return eccentricity[w] == upper[w]; }), open.end());
+		if (open.empty()) return searches;
+
+		int v = open[0];
+		for (int w : open) {
+			bool better = highest ? upper[w] > upper[v] : eccentricity[w] < eccentricity[v];
+			bool tied = highest ? upper[w] == upper[v] : eccentricity[w] == eccentricity[v];
+			if (better || (tied && c.degree(w) > c.degree(v))) v = w;
+		}
+		distance_search(c, v, length, ws);
+		++searches;
+	}
+}
+
+// The eccentricity of every vertex of a graph, the largest distance from it to a vertex it can reach,
+// with the diameter and radius of each connected component.
+template <typename vertex>
+struct eccentricity_report {
+	std::unordered_map<vertex, int> eccentricity;
+	std::vector<int> diameter; // by component, in the same order as connected_components
+	std::vector<int> radius;
+	int searches = 0; // how many single source searches it took in all
+};
+
+// Returns the eccentricity of every vertex of g, searching only where the bounds leave it unknown.
+template <typename vertex>
+eccentricity_report<vertex> eccentricities(const weighted_graph<vertex>& g, path_length length = path_length::weighted) {
+	csr_graph<vertex> c(g);
+	const int n = c.num_vertices();
+	traversal_workspace ws(n);
+	std::vector<int> eccentricity(n, -1), upper(n), members;
+	eccentricity_report<vertex> result;
+	result.eccentricity.reserve(n);
+	for (auto g_it = g.cbegin(); g_it != g.cend(); ++g_it) {
+		int u = c.index_of(*g_it);
+		if (eccentricity[u] != -1) continue;
+		result.searches += eccentricity_ids(c, u, length, ws, eccentricity, upper, members);
+		int diameter = 0, radius = std::numeric_limits<int>::max();
+		for (int w : members) {
+			diameter = std::max(diameter, eccentricity[w]);
+			radius = std::min(radius, eccentricity[w]);
+			result.eccentricity[c.vertex_at(w)] = eccentricity[w];
+		}
+		result.diameter.push_back(diameter);
+		result.radius.push_back(radius);
+	}
+	return result;
+}
+
+#endif
@@ -0,0 +1,74 @@
+#ifndef DISJOINT_SET_H
+#define DISJOINT_SET_H
+
+#include <vector>
+#include <utility>
+
+// A union-find over the ids 0..n-1, using union by rank and path compression,
+// so any sequence of operations runs in near-constant amortised time each.
+class disjoint_set {
+
+	private:
+
+	std::vector<int> parent;
+	std::vector<unsigned char> rank; // an upper bound on the height of each root's tree
+	int sets{0};
+
+	public:
+
+	disjoint_set();
+	explicit disjoint_set(int);
+
+	int add();
+	int find(int);
+	bool unite(int, int);
+	bool same_set(int, int);
+	int size() const;
+	int num_sets() const;
+
+};
+
+inline disjoint_set::disjoint_set() {}
+
+inline disjoint_set::disjoint_set(int n) : parent(n), rank(n, 0), sets(n) {
+	for (int i = 0; i < n; ++i) parent[i] = i;
+}
+
+// Adds a new singleton set and returns its id.
+inline int disjoint_set::add() {
+	parent.push_back(parent.size());
+	rank.push_back(0);
+	++sets;
+	return parent.size() - 1;
+}
+
+inline int disjoint_set::find(int x) {
+	int root = x;
+	while (parent[root] != root) root = parent[root];
+	// Point everything on the path straight at the root
+	while (parent[x] != root) {
+		int next = parent[x];
+		parent[x] = root;
+		x = next;
+	}
+	return root;
+}
+
+// Joins the sets holding a and b. Returns true if they were separate.
+inline bool disjoint_set::unite(int a, int b) {
+	a = find(a);
+	b = find(b);
+	if (a == b) return false;
+	// Hang the shallower tree beneath the deeper one
+	if (rank[a] < rank[b]) std::swap(a, b);
+	parent[b] = a;
+	if (rank[a] == rank[b]) ++rank[a];
+	--sets;
+	return true;
+}
+
+inline bool disjoint_set::same_set(int a, int b) { return find(a) == find(b); }
+inline int disjoint_set::size() const { return parent.size(); }
+inline int disjoint_set::num_sets() const { return sets; }
+
+#endif
@@ -0,0 +1,84 @@
+#ifndef DISTANCE_MATRIX
+#define DISTANCE_MATRIX
+
+#include <vector>
+#include <limits>
+#include <algorithm>
+#include "weighted_graph.hpp"
+#include "csr_graph.hpp"
+#include "thread_pool.hpp"
+#include "traversal_workspace.hpp"
+#include "graph_algorithms.cpp"
+
+// Writes the distance from every source id of c to every target id to distances, a row per source
+// and a column per target laid out row after row, the maximum int where a target cannot be reached.
+// A source or target of -1 is taken to be missing, and its row or column is all the maximum int.
+// The sources are searched in parallel, each worker reusing its own workspace, and every search
+// stops as soon as it has settled all of the targets, so a few nearby targets cost far less than
+// a full row.
+template <typename vertex>
+void distance_matrix_ids(const csr_graph<vertex>& c, const std::vector<int>& sources, const std::vector<int>& targets, thread_pool& pool, std::vector<int>& distances) {
+	const int n = c.num_vertices();
+	const long long columns = targets.size();
+	distances.assign(sources.size() * columns, std::numeric_limits<int>::max());
+	std::vector<char> is_target(n, 0);
+	int wanted = 0;
+	for (int t : targets) {
+		if (t >= 0 && !is_target[t]) ++wanted;
+		if (t >= 0) is_target[t] = 1;
+	}
+
+	std::vector<traversal_workspace> workspaces(pool.size());
+	pool.parallel_for(0, sources.size(), 1, [&](int begin, int end, int worker) {
+		traversal_workspace& ws = workspaces[worker];
+		for (int i = begin; i < end; ++i) {
+			int left = wanted;
+			shortest_path_ids(c, sources[i], ws, [&](int u, int) {
+				if (left == 0) return false;
+				left -= is_target[u];
+				return true;
+			});
+			int* row = distances.data() + i * columns;
+			for (int j = 0; j < columns; ++j) {
+				if (targets[j] >= 0) row[j] = ws.distance(targets[j]);
+			}
+		}
+	});
+}
+
+// Distances from a list of sources to a list of targets, a row per source and a column per
+// target, kept row after row in one array.
+template <typename vertex>
+struct distance_matrix {
+	std::vector<vertex> sources; // row -> vertex
+	std::vector<vertex> targets; // column -> vertex
+	std::vector<int> distances; // the maximum int where the target cannot be reached, or either is not in the graph
+
+	int at(int row, int column) const { return distances[row * static_cast<long long>(targets.size()) + column]; }
+	const int* row(int r) const { return distances.data() + r * static_cast<long long>(targets.size()); }
+};
+
+// Returns the distance from every one of sources to every one of targets in g.
+template <typename vertex>
+distance_matrix<vertex> distances_between(const weighted_graph<vertex>& g, const std::vector<vertex>& sources, const std::vector<vertex>& targets, thread_pool& pool) {
+	csr_graph<vertex> c(g);
+	auto ids = [&](const std::vector<vertex>& vertices) {
+		std::vector<int> found;
+		for (const vertex& u : vertices) found.push_back(c.has_vertex(u) ? c.index_of(u) : -1);
+		return found;
+	};
+	distance_matrix<vertex> matrix{sources, targets, {}};
+	distance_matrix_ids(c, ids(sources), ids(targets), pool, matrix.distances);
+	return matrix;
+}
+
+// Returns the distance from every one of sources to every vertex of g, the columns being the
+// vertices in ascending order.
+template <typename vertex>
+distance_matrix<vertex> distances_between(const weighted_graph<vertex>& g, const std::vector<vertex>& sources, thread_pool& pool) {
+	std::vector<vertex> targets(g.cbegin(), g.cend());
+	std::sort(targets.begin(), targets.end());
+	return distances_between(g, sources, targets, pool);
+}
+
+#endif
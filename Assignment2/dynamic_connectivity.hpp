@@ -0,0 +1,413 @@
+#ifndef DYNAMIC_CONNECTIVITY_H
+#define DYNAMIC_CONNECTIVITY_H
+
+#include <vector>
+#include <random>
+#include <cstdint>
+#include <utility>
+#include <unordered_map>
+#include <unordered_set>
+#include "weighted_graph.hpp"
+#include "graph_observer.hpp"
+
+// Fully dynamic connectivity (Holm, de Lichtenberg and Thorup).
+//
+// Every edge has a level, starting at 0. For each level i the structure keeps a spanning forest F_i
+// of the edges with level at least i, stored as Euler tour trees, so F_0 is a spanning forest of the
+// whole graph and connectivity queries are a root comparison in F_0, O(log V).
+// Deleting a tree edge of level l looks for a replacement edge from level l downwards. At each level
+// the smaller of the two halves has its level-i tree edges pushed up a level, and its non-tree edges
+// are tried in turn, each failed candidate also being pushed up a level. An edge can only rise
+// log V times, which pays for the searches: updates take O(log^2 V) amortised.
+//
+// It can be driven directly, or attached to a weighted_graph to follow its changes.
+template <typename vertex>
+class dynamic_connectivity : public graph_observer<vertex> {
+
+	// A node of an Euler tour, kept in a treap ordered by tour position. A tour holds one node per
+	// vertex and one per direction of every tree edge.
+	struct tour_node {
+		tour_node* left{nullptr};
+		tour_node* right{nullptr};
+		tour_node* parent{nullptr};
+		unsigned priority;
+		int count{1}; // nodes in this subtree
+		int vertex_count; // vertex nodes in this subtree
+		int from; // the vertex, or the tail of the arc
+		int to; // -1 for a vertex node, otherwise the head of the arc
+		bool tree_flag{false}; // arc: its edge is a tree edge of exactly this level. Vertex: unused
+		bool nontree_flag{false}; // vertex: it has non-tree edges of exactly this level
+		bool any_tree{false};
+		bool any_nontree{false};
+
+		tour_node(int u, int v, unsigned p) : priority(p), vertex_count(v == -1), from(u), to(v) {}
+	};
+
+	struct edge_state {
+		int level{0};
+		bool tree{false};
+		std::vector<std::pair<tour_node*, tour_node*>> arcs; // a tree edge's two arcs in every forest up to its level
+	};
+
+	private:
+
+	weighted_graph<vertex>* graph{nullptr};
+	std::mt19937 rng;
+
+	std::unordered_map<vertex, int> ids;
+	std::vector<vertex> vertices;
+	std::vector<int> free_ids;
+	int live_vertices{0};
+	int tree_edges{0};
+
+	std::vector<std::vector<tour_node*>> vertex_nodes; // [level][id]
+	std::vector<std::unordered_map<int, std::unordered_set<int>>> nontree; // [level][id] -> non-tree neighbours of that level
+	std::unordered_map<uint64_t, edge_state> edges;
+
+	static int count(tour_node* t) { return t ? t->count : 0; }
+	static void update(tour_node*);
+	static void update_path(tour_node*);
+	static tour_node* merge(tour_node*, tour_node*);
+	static std::pair<tour_node*, tour_node*> split(tour_node*, int);
+	static tour_node* root(tour_node*);
+	static int position(tour_node*);
+	static tour_node* reroot(tour_node*);
+
+	uint64_t key(int, int) const;
+	void ensure_level(int);
+	void link(int, int, int);
+	void cut(edge_state&, int);
+	void set_nontree(int, int, int, bool);
+	bool replace(int, int, int);
+
+	public:
+
+	dynamic_connectivity();
+	explicit dynamic_connectivity(weighted_graph<vertex>&);
+	~dynamic_connectivity();
+
+	dynamic_connectivity(const dynamic_connectivity&) = delete;
+	dynamic_connectivity& operator=(const dynamic_connectivity&) = delete;
+
+	void add_vertex(const vertex&);
+	void remove_vertex(const vertex&);
+	void add_edge(const vertex&, const vertex&);
+	void remove_edge(const vertex&, const vertex&);
+
+	bool connected(const vertex&, const vertex&) const;
+	int num_components() const;
+	int component_size(const vertex&) const;
+
+	void vertex_added(const vertex& v) override { add_vertex(v); }
+	void vertex_removed(const vertex& v) override { remove_vertex(v); }
+	void edge_added(const vertex& u, const vertex& v, int) override { add_edge(u, v); }
+	void edge_removed(const vertex& u, const vertex& v, int) override { remove_edge(u, v); }
+
+};
+
+template <typename vertex> dynamic_connectivity<vertex>::dynamic_connectivity() : rng(5489u) {}
+
+// Loads the current contents of g and then follows every change made to it.
+template <typename vertex> dynamic_connectivity<vertex>::dynamic_connectivity(weighted_graph<vertex>& g) : graph(&g), rng(5489u) {
+	for (auto u : g) add_vertex(u);
+	for (auto u : g) {
+		for (auto n_it = g.neighbours_begin(u); n_it != g.neighbours_end(u); ++n_it) add_edge(u, n_it->first);
+	}
+	g.attach(this);
+}
+
+template <typename vertex> dynamic_connectivity<vertex>::~dynamic_connectivity() {
+	if (graph) graph->detach(this);
+	for (auto& e : edges) {
+		for (auto a : e.second.arcs) {
+			delete a.first;
+			delete a.second;
+		}
+	}
+	for (auto& level : vertex_nodes) for (auto x : level) delete x;
+}
+
+template <typename vertex> void dynamic_connectivity<vertex>::update(tour_node* t) {
+	t->count = 1 + count(t->left) + count(t->right);
+	t->vertex_count = (t->to == -1) + (t->left ? t->left->vertex_count : 0) + (t->right ? t->right->vertex_count : 0);
+	t->any_tree = t->tree_flag || (t->left && t->left->any_tree) || (t->right && t->right->any_tree);
+	t->any_nontree = t->nontree_flag || (t->left && t->left->any_nontree) || (t->right && t->right->any_nontree);
+}
+
+template <typename vertex> void dynamic_connectivity<vertex>::update_path(tour_node* t) {
+	for (; t; t = t->parent) update(t);
+}
+
+template <typename vertex> typename dynamic_connectivity<vertex>::tour_node* dynamic_connectivity<vertex>::merge(tour_node* a, tour_node* b) {
+	if (!a) return b;
+	if (!b) return a;
+	if (a->priority > b->priority) {
+		a->right = merge(a->right, b);
+		a->right->parent = a;
+		update(a);
+		return a;
+	}
+	b->left = merge(a, b->left);
+	b->left->parent = b;
+	update(b);
+	return b;
+}
+
+// Splits the tour t into its first k nodes and the rest.
+template <typename vertex> std::pair<typename dynamic_connectivity<vertex>::tour_node*, typename dynamic_connectivity<vertex>::tour_node*> dynamic_connectivity<vertex>::split(tour_node* t, int k) {
+	if (!t) return {nullptr, nullptr};
+	t->parent = nullptr;
+	if (count(t->left) >= k) {
+		auto parts = split(t->left, k);
+		t->left = parts.second;
+		if (t->left) t->left->parent = t;
+		update(t);
+		return {parts.first, t};
+	}
+	auto parts = split(t->right, k - count(t->left) - 1);
+	t->right = parts.first;
+	if (t->right) t->right->parent = t;
+	update(t);
+	return {t, parts.second};
+}
+
+template <typename vertex> typename dynamic_connectivity<vertex>::tour_node* dynamic_connectivity<vertex>::root(tour_node* t) {
+	while (t->parent) t = t->parent;
+	return t;
+}
+
+// Returns the position of t within its tour.
+template <typename vertex> int dynamic_connectivity<vertex>::position(tour_node* t) {
+	int index = count(t->left);
+	for (; t->parent; t = t->parent) {
+		if (t->parent->right == t) index += count(t->parent->left) + 1;
+	}
+	return index;
+}
+
+// Rotates t's tour so that it starts at t, and returns the new root.
+template <typename vertex> typename dynamic_connectivity<vertex>::tour_node* dynamic_connectivity<vertex>::reroot(tour_node* t) {
+	int index = position(t);
+	auto parts = split(root(t), index);
+	return merge(parts.second, parts.first);
+}
+
+template <typename vertex> uint64_t dynamic_connectivity<vertex>::key(int u, int v) const {
+	if (u > v) std::swap(u, v);
+	return ((uint64_t)(uint32_t)u << 32) | (uint32_t)v;
+}
+
+// Makes sure forests exist up to the given level, each starting as one single-vertex tour per vertex.
+template <typename vertex> void dynamic_connectivity<vertex>::ensure_level(int level) {
+	while (vertex_nodes.size() <= level) {
+		vertex_nodes.push_back(std::vector<tour_node*>(vertices.size(), nullptr));
+		nontree.push_back(std::unordered_map<int, std::unordered_set<int>>());
+		auto& nodes = vertex_nodes.back();
+		for (int id = 0; id < vertices.size(); ++id) {
+			if (vertex_nodes[0][id]) nodes[id] = new tour_node(id, -1, rng());
+		}
+	}
+}
+
+// Joins the trees of u and v in the forest of the given level with the tree edge (u, v).
+template <typename vertex> void dynamic_connectivity<vertex>::link(int u, int v, int level) {
+	auto& e = edges.at(key(u, v));
+	tour_node* uv = new tour_node(u, v, rng());
+	tour_node* vu = new tour_node(v, u, rng());
+	e.arcs.push_back({uv, vu});
+	// Only the forest of the edge's own level flags it, so it can be found when that level is searched
+	if (level == e.level) {
+		uv->tree_flag = true;
+		update(uv);
+	}
+	tour_node* tu = reroot(vertex_nodes[level][u]);
+	tour_node* tv = reroot(vertex_nodes[level][v]);
+	merge(merge(merge(tu, uv), tv), vu);
+}
+
+// Removes the tree edge e from the forest of the given level, which must be its highest forest.
+template <typename vertex> void dynamic_connectivity<vertex>::cut(edge_state& e, int level) {
+	tour_node* a = e.arcs[level].first;
+	tour_node* b = e.arcs[level].second;
+	e.arcs.pop_back();
+	int i = position(a);
+	int j = position(b);
+	if (i > j) {
+		std::swap(i, j);
+		std::swap(a, b);
+	}
+	// The tour reads A a B b C; B is one side of the cut and A C the other
+	auto first = split(root(a), i);
+	auto second = split(first.second, 1);
+	auto third = split(second.second, j - i - 1);
+	auto fourth = split(third.second, 1);
+	merge(first.first, fourth.second);
+	delete a;
+	delete b;
+}
+
+// Records or forgets the non-tree edge (u, v) at the given level, keeping the vertex flags in step.
+template <typename vertex> void dynamic_connectivity<vertex>::set_nontree(int u, int v, int level, bool present) {
+	for (int side = 0; side < 2; ++side) {
+		int x = side == 0 ? u : v;
+		int y = side == 0 ? v : u;
+		auto& level_edges = nontree[level];
+		if (present) level_edges[x].insert(y);
+		else {
+			level_edges[x].erase(y);
+			if (level_edges[x].empty()) level_edges.erase(x);
+		}
+		tour_node* t = vertex_nodes[level][x];
+		bool flag = level_edges.count(x) > 0;
+		if (t->nontree_flag != flag) {
+			t->nontree_flag = flag;
+			update_path(t);
+		}
+	}
+}
+
+// Looks for an edge of the given level to reconnect u's and v's trees after the tree edge between
+// them was cut. Returns true if one was found and linked in.
+template <typename vertex> bool dynamic_connectivity<vertex>::replace(int u, int v, int level) {
+	tour_node* tu = root(vertex_nodes[level][u]);
+	tour_node* tv = root(vertex_nodes[level][v]);
+	tour_node* small = tu->vertex_count <= tv->vertex_count ? tu : tv;
+	ensure_level(level + 1);
+
+	// Push the smaller tree's level tree edges up a level. The two halves are at most half the
+	// original tree, which is what keeps every forest of level i to trees of at most V / 2^i vertices.
+	while (true) {
+		tour_node* t = root(small == tu ? vertex_nodes[level][u] : vertex_nodes[level][v]);
+		if (!t->any_tree) break;
+		while (!t->tree_flag) t = (t->left && t->left->any_tree) ? t->left : t->right;
+		int a = t->from;
+		int b = t->to;
+		t->tree_flag = false;
+		update_path(t);
+		auto& e = edges.at(key(a, b));
+		e.level = level + 1;
+		link(a, b, level + 1);
+	}
+
+	// Try the smaller tree's non-tree edges of this level as replacements
+	while (true) {
+		tour_node* t = root(small == tu ? vertex_nodes[level][u] : vertex_nodes[level][v]);
+		if (!t->any_nontree) return false;
+		while (!t->nontree_flag) t = (t->left && t->left->any_nontree) ? t->left : t->right;
+		int x = t->from;
+		std::vector<int> candidates(nontree[level][x].begin(), nontree[level][x].end());
+		for (int y : candidates) {
+			set_nontree(x, y, level, false);
+			auto& e = edges.at(key(x, y));
+			if (root(vertex_nodes[level][y]) != root(vertex_nodes[level][x])) {
+				// y is on the other side: (x, y) becomes a tree edge of this level in every forest up to it
+				e.tree = true;
+				++tree_edges;
+				for (int i = 0; i <= level; ++i) link(x, y, i);
+				return true;
+			}
+			// Both ends are in the small tree, so this edge can safely rise a level
+			e.level = level + 1;
+			set_nontree(x, y, level + 1, true);
+		}
+	}
+}
+
+template <typename vertex> void dynamic_connectivity<vertex>::add_vertex(const vertex& v) {
+	if (ids.count(v) > 0) return;
+	int id;
+	if (!free_ids.empty()) {
+		id = free_ids.back();
+		free_ids.pop_back();
+		vertices[id] = v;
+	}
+	else {
+		id = vertices.size();
+		vertices.push_back(v);
+		for (auto& level : vertex_nodes) level.push_back(nullptr);
+	}
+	ids[v] = id;
+	ensure_level(0);
+	for (auto& level : vertex_nodes) level[id] = new tour_node(id, -1, rng());
+	++live_vertices;
+}
+
+template <typename vertex> void dynamic_connectivity<vertex>::remove_vertex(const vertex& v) {
+	if (ids.count(v) == 0) return;
+	int id = ids.at(v);
+	// A vertex with any edges has a tree edge, so a vertex alone in its tour has none. When attached
+	// to a graph that is always the case here, as the graph reports each edge's removal first.
+	if (root(vertex_nodes[0][id])->count > 1) {
+		// Used directly, find the remaining edges with a scan over all of them
+		std::vector<int> neighbours;
+		for (auto& e : edges) {
+			int a = e.first >> 32;
+			int b = e.first & 0xffffffff;
+			if (a == id) neighbours.push_back(b);
+			else if (b == id) neighbours.push_back(a);
+		}
+		for (int w : neighbours) remove_edge(v, vertices[w]);
+	}
+
+	for (auto& level : vertex_nodes) {
+		delete level[id];
+		level[id] = nullptr;
+	}
+	ids.erase(v);
+	free_ids.push_back(id);
+	--live_vertices;
+}
+
+template <typename vertex> void dynamic_connectivity<vertex>::add_edge(const vertex& a, const vertex& b) {
+	if (ids.count(a) == 0 || ids.count(b) == 0) return;
+	int u = ids.at(a);
+	int v = ids.at(b);
+	if (u == v || edges.count(key(u, v)) > 0) return;
+	auto& e = edges[key(u, v)];
+	if (root(vertex_nodes[0][u]) != root(vertex_nodes[0][v])) {
+		e.tree = true;
+		++tree_edges;
+		link(u, v, 0);
+	}
+	else {
+		set_nontree(u, v, 0, true);
+	}
+}
+
+template <typename vertex> void dynamic_connectivity<vertex>::remove_edge(const vertex& a, const vertex& b) {
+	if (ids.count(a) == 0 || ids.count(b) == 0) return;
+	int u = ids.at(a);
+	int v = ids.at(b);
+	auto found = edges.find(key(u, v));
+	if (found == edges.end()) return;
+	edge_state& e = found->second;
+	int level = e.level;
+
+	if (!e.tree) {
+		set_nontree(u, v, level, false);
+		edges.erase(found);
+		return;
+	}
+
+	for (int i = level; i >= 0; --i) cut(e, i);
+	edges.erase(found);
+	--tree_edges;
+	for (int i = level; i >= 0; --i) {
+		if (replace(u, v, i)) return;
+	}
+}
+
+template <typename vertex> bool dynamic_connectivity<vertex>::connected(const vertex& a, const vertex& b) const {
+	if (ids.count(a) == 0 || ids.count(b) == 0) return false;
+	return root(vertex_nodes[0][ids.at(a)]) == root(vertex_nodes[0][ids.at(b)]);
+}
+
+// A spanning forest has one tree edge fewer than vertices in each of its trees.
+template <typename vertex> int dynamic_connectivity<vertex>::num_components() const { return live_vertices - tree_edges; }
+
+template <typename vertex> int dynamic_connectivity<vertex>::component_size(const vertex& a) const {
+	if (ids.count(a) == 0) return 0;
+	return root(vertex_nodes[0][ids.at(a)])->vertex_count;
+}
+
+#endif
@@ -0,0 +1,256 @@
+#ifndef DYNAMIC_SHORTEST_PATHS_H
+#define DYNAMIC_SHORTEST_PATHS_H
+
+#include <vector>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+#include <algorithm>
+#include <unordered_map>
+#include "weighted_graph.hpp"
+#include "graph_observer.hpp"
+
+// Shortest path distances from a fixed set of sources, repaired after every change to a
+// weighted_graph instead of being recomputed (Ramalingam and Reps).
+//
+// An edge that gets lighter, or a new edge, can only shorten paths through it, so a search from
+// its far end that only goes on while distances keep dropping finds everything that improved. An
+// edge that gets heavier, or is removed, only matters if it lay on a shortest path. Then the
+// vertices that have lost every shortest path are found first, in order of their old distance:
+// a vertex is affected if no unaffected neighbour still gives it its old distance, and only an
+// affected vertex's children in the old shortest path graph need to be checked after it. Their
+// new distances are then settled by a search confined to the affected vertices, starting from the
+// best edge into each from outside. Either way the work is in proportion to the vertices whose
+// distances change and their edges, which is usually a small part of the graph.
+//
+// Edge weights must be positive. The count of vertices each repair looked at is kept per update.
+template <typename vertex>
+class dynamic_shortest_paths : public graph_observer<vertex> {
+
+	struct source_tree {
+		vertex source;
+		std::unordered_map<vertex, int> distance; // every vertex, the maximum int if unreachable
+	};
+
+	private:
+
+	weighted_graph<vertex>* graph;
+	std::vector<source_tree> trees;
+
+	std::vector<std::pair<int, vertex>> heap; // (distance, vertex), kept as a min-heap by distance
+	int touched{0};
+	long long touched_in_total{0};
+
+	void push(int, const vertex&);
+	std::pair<int, vertex> pop();
+	void search(source_tree&);
+	void shortened(source_tree&, const vertex&, const vertex&, int);
+	void lengthened(source_tree&, const vertex&, const vertex&, int);
+
+	public:
+
+	dynamic_shortest_paths(weighted_graph<vertex>&, const std::vector<vertex>&);
+	~dynamic_shortest_paths();
+
+	dynamic_shortest_paths(const dynamic_shortest_paths&) = delete;
+	dynamic_shortest_paths& operator=(const dynamic_shortest_paths&) = delete;
+
+	int distance(const vertex&, const vertex&) const;
+	const std::unordered_map<vertex, int>& distances(const vertex&) const;
+	int last_touched() const;
+	long long total_touched() const;
+
+	void vertex_added(const vertex&) override;
+	void vertex_removed(const vertex&) override;
+	void edge_added(const vertex&, const vertex&, int) override;
+	void edge_removed(const vertex&, const vertex&, int) override;
+	void edge_weight_changed(const vertex&, const vertex&, int, int) override;
+
+};
+
+// Finds the distances from every source in g, then follows every change made to it. Sources that
+// are not in g are left out.
+template <typename vertex> dynamic_shortest_paths<vertex>::dynamic_shortest_paths(weighted_graph<vertex>& g, const std::vector<vertex>& sources) : graph(&g) {
+	for (const vertex& s : sources) {
+		if (!g.has_vertex(s)) continue;
+		trees.push_back({s, {}});
+		search(trees.back());
+	}
+	g.attach(this);
+}
+
+template <typename vertex> dynamic_shortest_paths<vertex>::~dynamic_shortest_paths() {
+	graph->detach(this);
+}
+
+template <typename vertex> void dynamic_shortest_paths<vertex>::push(int d, const vertex& u) {
+	heap.push_back({d, u});
+	std::push_heap(heap.begin(), heap.end(), [](const std::pair<int, vertex>& a, const std::pair<int, vertex>& b) { return a.first > b.first; });
+}
+
+template <typename vertex> std::pair<int, vertex> dynamic_shortest_paths<vertex>::pop() {
+	std::pop_heap(heap.begin(), heap.end(), [](const std::pair<int, vertex>& a, const std::pair<int, vertex>& b) { return a.first > b.first; });
+	std::pair<int, vertex> top = heap.back();
+	heap.pop_back();
+	return top;
+}
+
+// Fills in the tree's distances from scratch with a heap-based Dijkstra's.
+template <typename vertex> void dynamic_shortest_paths<vertex>::search(source_tree& tree) {
+	auto& distance = tree.distance;
+	distance.clear();
+	distance.reserve(graph->num_vertices());
+	for (auto g_it = graph->cbegin(); g_it != graph->cend(); ++g_it) distance[*g_it] = std::numeric_limits<int>::max();
+	distance[tree.source] = 0;
+	push(0, tree.source);
+	while (!heap.empty()) {
+		auto top = pop();
+		if (top.first != distance.at(top.second)) continue;
+		for (auto n_it = graph->cneighbours_begin(top.second); n_it != graph->cneighbours_end(top.second); ++n_it) {
+			int& d = distance.at(n_it->first);
+			if (top.first + n_it->second < d) {
+				d = top.first + n_it->second;
+				push(d, n_it->first);
+			}
+		}
+	}
+}
+
+// Repairs the tree after the edge (u, v) became weight long, or appeared with that weight.
+template <typename vertex> void dynamic_shortest_paths<vertex>::shortened(source_tree& tree, const vertex& u, const vertex& v, int weight) {
+	auto& distance = tree.distance;
+	const int infinity = std::numeric_limits<int>::max();
+	int du = distance.at(u), dv = distance.at(v);
+	// Only the end that is further away can get closer
+	if (du != infinity && du + weight < dv) {
+		distance[v] = du + weight;
+		push(du + weight, v);
+	} else if (dv != infinity && dv + weight < du) {
+		distance[u] = dv + weight;
+		push(dv + weight, u);
+	}
+	while (!heap.empty()) {
+		auto top = pop();
+		if (top.first != distance.at(top.second)) continue;
+		++touched;
+		for (auto n_it = graph->cneighbours_begin(top.second); n_it != graph->cneighbours_end(top.second); ++n_it) {
+			int& d = distance.at(n_it->first);
+			if (top.first + n_it->second < d) {
+				d = top.first + n_it->second;
+				push(d, n_it->first);
+			}
+		}
+	}
+}
+
+// Repairs the tree after the edge (u, v), which was weight long, became heavier or was removed.
+template <typename vertex> void dynamic_shortest_paths<vertex>::lengthened(source_tree& tree, const vertex& u, const vertex& v, int weight) {
+	auto& distance = tree.distance;
+	const int infinity = std::numeric_limits<int>::max();
+	int du = distance.at(u), dv = distance.at(v);
+	// Nothing changes unless the edge led to one of its ends along a shortest path
+	if (du != infinity && du + weight == dv) push(dv, v);
+	else if (dv != infinity && dv + weight == du) push(du, u);
+	else return;
+
+	// Decide which vertices lost every shortest path, nearest first, so that each vertex's parents
+	// in the old shortest path graph have all been decided by the time it is
+	std::unordered_map<vertex, bool> examined; // vertex -> whether it lost every shortest path
+	auto affected = [&](const vertex& y) {
+		auto e_it = examined.find(y);
+		return e_it != examined.end() && e_it->second;
+	};
+	std::vector<vertex> lost;
+	while (!heap.empty()) {
+		vertex x = pop().second;
+		if (examined.count(x)) continue;
+		++touched;
+		bool kept = x == tree.source;
+		for (auto n_it = graph->cneighbours_begin(x); n_it != graph->cneighbours_end(x) && !kept; ++n_it) {
+			int dy = distance.at(n_it->first);
+			kept = dy != infinity && dy + n_it->second == distance.at(x) && !affected(n_it->first);
+		}
+		examined[x] = !kept;
+		if (kept) continue;
+		lost.push_back(x);
+		for (auto n_it = graph->cneighbours_begin(x); n_it != graph->cneighbours_end(x); ++n_it) {
+			if (distance.at(x) + n_it->second == distance.at(n_it->first)) push(distance.at(n_it->first), n_it->first);
+		}
+	}
+
+	// Each affected vertex starts from its best edge in from an unaffected one, and the rest is
+	// settled by a search that stays among the affected vertices
+	for (const vertex& x : lost) {
+		int best = infinity;
+		for (auto n_it = graph->cneighbours_begin(x); n_it != graph->cneighbours_end(x); ++n_it) {
+			int dy = distance.at(n_it->first);
+			if (dy != infinity && !affected(n_it->first)) best = std::min(best, dy + n_it->second);
+		}
+		distance[x] = best;
+	}
+	for (const vertex& x : lost) if (distance.at(x) != infinity) push(distance.at(x), x);
+	while (!heap.empty()) {
+		auto top = pop();
+		if (top.first != distance.at(top.second)) continue;
+		for (auto n_it = graph->cneighbours_begin(top.second); n_it != graph->cneighbours_end(top.second); ++n_it) {
+			if (!affected(n_it->first)) continue;
+			int& d = distance.at(n_it->first);
+			if (top.first + n_it->second < d) {
+				d = top.first + n_it->second;
+				push(d, n_it->first);
+			}
+		}
+	}
+}
+
+// Returns the distance from source to v, or the maximum int if v cannot be reached.
+template <typename vertex> int dynamic_shortest_paths<vertex>::distance(const vertex& source, const vertex& v) const {
+	return distances(source).at(v);
+}
+
+// Returns the distance from source to every vertex. Throws std::out_of_range if it is not a source.
+template <typename vertex> const std::unordered_map<vertex, int>& dynamic_shortest_paths<vertex>::distances(const vertex& source) const {
+	for (const auto& tree : trees) if (tree.source == source) return tree.distance;
+	throw std::out_of_range("not a source");
+}
+
+// Returns how many vertices the last repair looked at, over all the sources.
+template <typename vertex> int dynamic_shortest_paths<vertex>::last_touched() const { return touched; }
+
+// Returns how many vertices every repair so far has looked at.
+template <typename vertex> long long dynamic_shortest_paths<vertex>::total_touched() const { return touched_in_total; }
+
+template <typename vertex> void dynamic_shortest_paths<vertex>::vertex_added(const vertex& v) {
+	touched = 0;
+	for (auto& tree : trees) tree.distance[v] = std::numeric_limits<int>::max();
+}
+
+// Its edges have all been removed already, so it is unreachable; a source that is removed goes too.
+template <typename vertex> void dynamic_shortest_paths<vertex>::vertex_removed(const vertex& v) {
+	touched = 0;
+	trees.erase(std::remove_if(trees.begin(), trees.end(), [&](const source_tree& tree) { return tree.source == v; }), trees.end());
+	for (auto& tree : trees) tree.distance.erase(v);
+}
+
+template <typename vertex> void dynamic_shortest_paths<vertex>::edge_added(const vertex& u, const vertex& v, int weight) {
+	touched = 0;
+	for (auto& tree : trees) shortened(tree, u, v, weight);
+	touched_in_total += touched;
+}
+
+template <typename vertex> void dynamic_shortest_paths<vertex>::edge_removed(const vertex& u, const vertex& v, int weight) {
+	touched = 0;
+	for (auto& tree : trees) lengthened(tree, u, v, weight);
+	touched_in_total += touched;
+}
+
+template <typename vertex> void dynamic_shortest_paths<vertex>::edge_weight_changed(const vertex& u, const vertex& v, int old_weight, int new_weight) {
+	touched = 0;
+	for (auto& tree : trees) {
+		if (new_weight < old_weight) shortened(tree, u, v, new_weight);
+		else if (new_weight > old_weight) lengthened(tree, u, v, old_weight);
+	}
+	touched_in_total += touched;
+}
+
+#endif
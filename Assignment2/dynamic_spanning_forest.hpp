@@ -0,0 +1,446 @@
+#ifndef DYNAMIC_SPANNING_FOREST_H
+#define DYNAMIC_SPANNING_FOREST_H
+
+#include <vector>
+#include <limits>
+#include <cstdint>
+#include <utility>
+#include <unordered_map>
+#include <unordered_set>
+#include "weighted_graph.hpp"
+#include "graph_observer.hpp"
+
+// A minimum spanning forest that is repaired after every change instead of being rebuilt.
+//
+// The forest is held in a link-cut tree in which every forest edge has a node of its own between
+// its two ends, so the heaviest edge on the path between any two vertices is found in O(log V)
+// amortised. A new edge, or a non-forest edge made lighter, closes a cycle with the forest: it
+// replaces the heaviest edge on that cycle if it is lighter. When a forest edge is removed, or
+// made heavier, it is cut, and the lightest edge reconnecting the two halves goes back in. That
+// edge is found by searching both halves' forest edges in step until the smaller one is complete,
+// then trying the graph edges leaving it, which costs time in proportion to the smaller half.
+// The total weight of the forest is kept up to date throughout, so reading it is O(1).
+//
+// It can be driven directly, or attached to a weighted_graph to follow its changes.
+template <typename vertex>
+class dynamic_spanning_forest : public graph_observer<vertex> {
+
+	// A node of the link-cut tree: a vertex, or a forest edge with its ends u and v.
+	// Its children form a splay tree over a path of the forest, ordered by depth.
+	struct lct_node {
+		int child[2]{-1, -1};
+		int parent{-1}; // splay parent, or the path parent for the root of a splay tree
+		bool flip{false}; // this splay subtree's path is to be reversed
+		int weight; // the lowest int for a vertex, so a path's heaviest node is always an edge
+		int heaviest; // the heaviest node in this splay subtree
+		int u{-1};
+		int v{-1};
+	};
+
+	struct edge_state {
+		int weight;
+		int node{-1}; // the link-cut node of a forest edge, and -1 for any other
+	};
+
+	private:
+
+	weighted_graph<vertex>* graph{nullptr};
+
+	std::unordered_map<vertex, int> ids;
+	std::vector<vertex> vertices;
+	std::vector<int> free_ids;
+	std::vector<int> vertex_node; // id -> link-cut node
+
+	mutable std::vector<lct_node> nodes; // splayed by queries too, so mutable
+	std::vector<int> free_nodes;
+	mutable std::vector<int> splay_path;
+
+	std::vector<std::unordered_set<int>> adjacency; // id -> neighbours in the graph
+	std::vector<std::unordered_set<int>> forest_adjacency; // id -> neighbours in the forest
+	std::unordered_map<uint64_t, edge_state> edges;
+
+	std::vector<unsigned> side_mark; // which half a vertex was found in by the last replacement search
+	unsigned side_stamp{0};
+
+	long long weight_total{0};
+	int forest_edges{0};
+
+	bool is_splay_root(int) const;
+	void pull(int) const;
+	void push(int) const;
+	void rotate(int) const;
+	void splay(int) const;
+	void access(int) const;
+	void make_root(int) const;
+	int find_root(int) const;
+	void link(int, int);
+	void cut(int, int);
+
+	int new_node(int, int, int);
+	uint64_t key(int, int) const;
+	void insert_forest_edge(int, int, edge_state&);
+	void remove_forest_edge(int, int, edge_state&);
+	void reconnect(int, int);
+	void offer(int, int, edge_state&);
+
+	public:
+
+	dynamic_spanning_forest();
+	explicit dynamic_spanning_forest(weighted_graph<vertex>&);
+	~dynamic_spanning_forest();
+
+	dynamic_spanning_forest(const dynamic_spanning_forest&) = delete;
+	dynamic_spanning_forest& operator=(const dynamic_spanning_forest&) = delete;
+
+	void add_vertex(const vertex&);
+	void remove_vertex(const vertex&);
+	void add_edge(const vertex&, const vertex&, int);
+	void remove_edge(const vertex&, const vertex&);
+	void set_edge_weight(const vertex&, const vertex&, int);
+
+	long long total_weight() const;
+	int num_edges() const;
+	bool in_forest(const vertex&, const vertex&) const;
+	bool connected(const vertex&, const vertex&) const;
+	weighted_graph<vertex> forest() const;
+
+	void vertex_added(const vertex& v) override { add_vertex(v); }
+	void vertex_removed(const vertex& v) override { remove_vertex(v); }
+	void edge_added(const vertex& u, const vertex& v, int w) override { add_edge(u, v, w); }
+	void edge_removed(const vertex& u, const vertex& v, int) override { remove_edge(u, v); }
+	void edge_weight_changed(const vertex& u, const vertex& v, int, int w) override { set_edge_weight(u, v, w); }
+
+};
+
+template <typename vertex> dynamic_spanning_forest<vertex>::dynamic_spanning_forest() {}
+
+// Loads the current contents of g and then follows every change made to it.
+template <typename vertex> dynamic_spanning_forest<vertex>::dynamic_spanning_forest(weighted_graph<vertex>& g) : graph(&g) {
+	for (auto u : g) add_vertex(u);
+	for (auto u : g) {
+		for (auto n_it = g.neighbours_begin(u); n_it != g.neighbours_end(u); ++n_it) add_edge(u, n_it->first, n_it->second);
+	}
+	g.attach(this);
+}
+
+template <typename vertex> dynamic_spanning_forest<vertex>::~dynamic_spanning_forest() {
+	if (graph) graph->detach(this);
+}
+
+template <typename vertex> bool dynamic_spanning_forest<vertex>::is_splay_root(int x) const {
+	int p = nodes[x].parent;
+	return p == -1 || (nodes[p].child[0] != x && nodes[p].child[1] != x);
+}
+
+template <typename vertex> void dynamic_spanning_forest<vertex>::pull(int x) const {
+	int heaviest = x;
+	for (int c : nodes[x].child) {
+		if (c != -1 && nodes[nodes[c].heaviest].weight > nodes[heaviest].weight) heaviest = nodes[c].heaviest;
+	}
+	nodes[x].heaviest = heaviest;
+}
+
+template <typename vertex> void dynamic_spanning_forest<vertex>::push(int x) const {
+	if (!nodes[x].flip) return;
+	std::swap(nodes[x].child[0], nodes[x].child[1]);
+	for (int c : nodes[x].child) if (c != -1) nodes[c].flip = !nodes[c].flip;
+	nodes[x].flip = false;
+}
+
+template <typename vertex> void dynamic_spanning_forest<vertex>::rotate(int x) const {
+	int p = nodes[x].parent;
+	int g = nodes[p].parent;
+	int side = nodes[p].child[1] == x;
+	if (!is_splay_root(p)) nodes[g].child[nodes[g].child[1] == p] = x;
+	nodes[x].parent = g;
+	int moved = nodes[x].child[!side];
+	nodes[p].child[side] = moved;
+	if (moved != -1) nodes[moved].parent = p;
+	nodes[x].child[!side] = p;
+	nodes[p].parent = x;
+	pull(p);
+	pull(x);
+}
+
+// Brings x to the root of its splay tree.
+template <typename vertex> void dynamic_spanning_forest<vertex>::splay(int x) const {
+	// Pending reversals have to be applied from the top down before the shape changes
+	splay_path.assign(1, x);
+	while (!is_splay_root(splay_path.back())) splay_path.push_back(nodes[splay_path.back()].parent);
+	for (auto p_it = splay_path.rbegin(); p_it != splay_path.rend(); ++p_it) push(*p_it);
+
+	while (!is_splay_root(x)) {
+		int p = nodes[x].parent;
+		if (!is_splay_root(p)) {
+			int g = nodes[p].parent;
+			bool zig_zig = (nodes[g].child[1] == p) == (nodes[p].child[1] == x);
+			rotate(zig_zig ? p : x);
+		}
+		rotate(x);
+	}
+}
+
+// Makes the path from x up to the root of its tree a single splay tree, rooted at x.
+template <typename vertex> void dynamic_spanning_forest<vertex>::access(int x) const {
+	int below = -1;
+	for (int y = x; y != -1; y = nodes[y].parent) {
+		splay(y);
+		nodes[y].child[1] = below;
+		pull(y);
+		below = y;
+	}
+	splay(x);
+}
+
+template <typename vertex> void dynamic_spanning_forest<vertex>::make_root(int x) const {
+	access(x);
+	nodes[x].flip = !nodes[x].flip;
+}
+
+template <typename vertex> int dynamic_spanning_forest<vertex>::find_root(int x) const {
+	access(x);
+	while (true) {
+		push(x);
+		if (nodes[x].child[0] == -1) break;
+		x = nodes[x].child[0];
+	}
+	splay(x);
+	return x;
+}
+
+// Joins the trees of x and y, which must be different, with an edge between them.
+template <typename vertex> void dynamic_spanning_forest<vertex>::link(int x, int y) {
+	make_root(x);
+	nodes[x].parent = y;
+}
+
+// Separates x from y, which must be adjacent in the link-cut tree.
+template <typename vertex> void dynamic_spanning_forest<vertex>::cut(int x, int y) {
+	make_root(x);
+	access(y);
+	// The path is just x then y, so x is all that is left of y
+	nodes[y].child[0] = -1;
+	nodes[x].parent = -1;
+	pull(y);
+}
+
+template <typename vertex> int dynamic_spanning_forest<vertex>::new_node(int weight, int u, int v) {
+	int x;
+	if (!free_nodes.empty()) {
+		x = free_nodes.back();
+		free_nodes.pop_back();
+		nodes[x] = lct_node();
+	}
+	else {
+		x = nodes.size();
+		nodes.emplace_back();
+	}
+	nodes[x].weight = weight;
+	nodes[x].heaviest = x;
+	nodes[x].u = u;
+	nodes[x].v = v;
+	return x;
+}
+
+template <typename vertex> uint64_t dynamic_spanning_forest<vertex>::key(int u, int v) const {
+	if (u > v) std::swap(u, v);
+	return ((uint64_t)(uint32_t)u << 32) | (uint32_t)v;
+}
+
+template <typename vertex> void dynamic_spanning_forest<vertex>::insert_forest_edge(int u, int v, edge_state& e) {
+	e.node = new_node(e.weight, u, v);
+	link(vertex_node[u], e.node);
+	link(e.node, vertex_node[v]);
+	forest_adjacency[u].insert(v);
+	forest_adjacency[v].insert(u);
+	weight_total += e.weight;
+	++forest_edges;
+}
+
+template <typename vertex> void dynamic_spanning_forest<vertex>::remove_forest_edge(int u, int v, edge_state& e) {
+	cut(vertex_node[u], e.node);
+	cut(e.node, vertex_node[v]);
+	free_nodes.push_back(e.node);
+	e.node = -1;
+	forest_adjacency[u].erase(v);
+	forest_adjacency[v].erase(u);
+	weight_total -= e.weight;
+	--forest_edges;
+}
+
+// Puts the lightest graph edge between the trees of u and v, just split apart, into the forest.
+template <typename vertex> void dynamic_spanning_forest<vertex>::reconnect(int u, int v) {
+	// Walk both trees a vertex at a time, so the walk stops once the smaller has been seen in full
+	if (side_stamp >= std::numeric_limits<unsigned>::max() - 2) {
+		std::fill(side_mark.begin(), side_mark.end(), 0);
+		side_stamp = 0;
+	}
+	side_stamp += 2;
+	const unsigned sides[2] = {side_stamp, side_stamp + 1};
+	std::vector<int> found[2] = {{u}, {v}};
+	side_mark[u] = sides[0];
+	side_mark[v] = sides[1];
+	int smaller = -1;
+	for (int next[2] = {0, 0}; smaller == -1;) {
+		for (int s = 0; s < 2 && smaller == -1; ++s) {
+			if (next[s] == found[s].size()) {
+				smaller = s;
+				break;
+			}
+			for (int y : forest_adjacency[found[s][next[s]++]]) {
+				if (side_mark[y] != sides[s]) {
+					side_mark[y] = sides[s];
+					found[s].push_back(y);
+				}
+			}
+		}
+	}
+
+	// Any graph edge out of the smaller tree now crosses to the other one
+	int best_u = -1, best_v = -1, best_weight = std::numeric_limits<int>::max();
+	for (int x : found[smaller]) {
+		for (int y : adjacency[x]) {
+			if (side_mark[y] == sides[smaller]) continue;
+			int w = edges.at(key(x, y)).weight;
+			if (best_u == -1 || w < best_weight) {
+				best_u = x;
+				best_v = y;
+				best_weight = w;
+			}
+		}
+	}
+	if (best_u != -1) insert_forest_edge(best_u, best_v, edges.at(key(best_u, best_v)));
+}
+
+// Brings the non-forest edge (u, v) into the forest if that makes it lighter.
+template <typename vertex> void dynamic_spanning_forest<vertex>::offer(int u, int v, edge_state& e) {
+	if (find_root(vertex_node[u]) != find_root(vertex_node[v])) {
+		insert_forest_edge(u, v, e);
+		return;
+	}
+	make_root(vertex_node[u]);
+	access(vertex_node[v]);
+	int heaviest = nodes[vertex_node[v]].heaviest;
+	if (nodes[heaviest].weight <= e.weight) return;
+	int a = nodes[heaviest].u, b = nodes[heaviest].v;
+	remove_forest_edge(a, b, edges.at(key(a, b)));
+	insert_forest_edge(u, v, e);
+}
+
+template <typename vertex> void dynamic_spanning_forest<vertex>::add_vertex(const vertex& v) {
+	if (ids.count(v) > 0) return;
+	int id;
+	if (!free_ids.empty()) {
+		id = free_ids.back();
+		free_ids.pop_back();
+		vertices[id] = v;
+	}
+	else {
+		id = vertices.size();
+		vertices.push_back(v);
+		vertex_node.push_back(-1);
+		adjacency.emplace_back();
+		forest_adjacency.emplace_back();
+		side_mark.push_back(0);
+	}
+	ids[v] = id;
+	vertex_node[id] = new_node(std::numeric_limits<int>::min(), id, id);
+}
+
+template <typename vertex> void dynamic_spanning_forest<vertex>::remove_vertex(const vertex& v) {
+	if (ids.count(v) == 0) return;
+	int id = ids.at(v);
+	// Attached to a graph the edges are already gone, as the graph reports each removal first
+	std::vector<int> neighbours(adjacency[id].begin(), adjacency[id].end());
+	for (int w : neighbours) remove_edge(v, vertices[w]);
+	free_nodes.push_back(vertex_node[id]);
+	vertex_node[id] = -1;
+	ids.erase(v);
+	free_ids.push_back(id);
+}
+
+template <typename vertex> void dynamic_spanning_forest<vertex>::add_edge(const vertex& a, const vertex& b, int weight) {
+	if (ids.count(a) == 0 || ids.count(b) == 0) return;
+	int u = ids.at(a);
+	int v = ids.at(b);
+	if (u == v || edges.count(key(u, v)) > 0) return;
+	edge_state& e = edges[key(u, v)];
+	e.weight = weight;
+	adjacency[u].insert(v);
+	adjacency[v].insert(u);
+	offer(u, v, e);
+}
+
+template <typename vertex> void dynamic_spanning_forest<vertex>::remove_edge(const vertex& a, const vertex& b) {
+	if (ids.count(a) == 0 || ids.count(b) == 0) return;
+	int u = ids.at(a);
+	int v = ids.at(b);
+	auto found = edges.find(key(u, v));
+	if (found == edges.end()) return;
+	adjacency[u].erase(v);
+	adjacency[v].erase(u);
+	bool was_forest = found->second.node != -1;
+	if (was_forest) remove_forest_edge(u, v, found->second);
+	edges.erase(found);
+	if (was_forest) reconnect(u, v);
+}
+
+template <typename vertex> void dynamic_spanning_forest<vertex>::set_edge_weight(const vertex& a, const vertex& b, int weight) {
+	if (ids.count(a) == 0 || ids.count(b) == 0) return;
+	int u = ids.at(a);
+	int v = ids.at(b);
+	auto found = edges.find(key(u, v));
+	if (found == edges.end()) {
+		add_edge(a, b, weight);
+		return;
+	}
+	edge_state& e = found->second;
+	if (e.node == -1) {
+		// Only a lighter edge can displace one in the forest
+		bool lighter = weight < e.weight;
+		e.weight = weight;
+		if (lighter) offer(u, v, e);
+	}
+	else if (weight <= e.weight) {
+		// A forest edge made lighter stays in the forest; only its node needs the new weight
+		weight_total += weight - e.weight;
+		e.weight = weight;
+		splay(e.node);
+		nodes[e.node].weight = weight;
+		pull(e.node);
+	}
+	else {
+		// Made heavier, it competes with every other edge across the cut for its place
+		remove_forest_edge(u, v, e);
+		e.weight = weight;
+		reconnect(u, v);
+	}
+}
+
+// Returns the total weight of the forest's edges.
+template <typename vertex> long long dynamic_spanning_forest<vertex>::total_weight() const { return weight_total; }
+
+template <typename vertex> int dynamic_spanning_forest<vertex>::num_edges() const { return forest_edges; }
+
+template <typename vertex> bool dynamic_spanning_forest<vertex>::in_forest(const vertex& a, const vertex& b) const {
+	if (ids.count(a) == 0 || ids.count(b) == 0) return false;
+	auto found = edges.find(key(ids.at(a), ids.at(b)));
+	return found != edges.end() && found->second.node != -1;
+}
+
+template <typename vertex> bool dynamic_spanning_forest<vertex>::connected(const vertex& a, const vertex& b) const {
+	if (ids.count(a) == 0 || ids.count(b) == 0) return false;
+	return find_root(vertex_node[ids.at(a)]) == find_root(vertex_node[ids.at(b)]);
+}
+
+// Returns the current forest as a graph with every vertex.
+template <typename vertex> weighted_graph<vertex> dynamic_spanning_forest<vertex>::forest() const {
+	weighted_graph<vertex> f;
+	for (auto& id : ids) f.add_vertex(id.first);
+	for (auto& e : edges) {
+		if (e.second.node != -1) f.add_edge(vertices[e.first >> 32], vertices[e.first & 0xffffffff], e.second.weight);
+	}
+	return f;
+}
+
+#endif
@@ -4,11 +4,24 @@
 #include <vector>
 #include <stack>
 #include <queue>
+#include <deque>
+#include <cstddef>
+#include <iterator>
+#include <algorithm>
 #include <unordered_set>
 #include "weighted_graph.hpp"
+#include "csr_graph.hpp"
+#include "traversal_workspace.hpp"
+
+// How a traversal of a weighted_graph chooses between the neighbours of a vertex.
+// sorted visits them in ascending order, which makes the traversal deterministic but sorts every
+// vertex's neighbours as it goes. unordered takes them in whatever order the graph stores them,
+// for callers that only care which vertices are reached. Repeated sorted traversals of a graph
+// that is not changing are cheaper over a csr_graph snapshot, using the overloads further down.
+enum class traversal_order { sorted, unordered };
 
 template <typename vertex> 
-std::vector<vertex> depth_first(const weighted_graph<vertex>& g, const vertex& start_vertex) {
+std::vector<vertex> depth_first(const weighted_graph<vertex>& g, const vertex& start_vertex, traversal_order order = traversal_order::sorted) {
 
 	std::vector<vertex> df_order;
 	std::unordered_set<vertex> visited;
@@ -23,6 +36,12 @@ std::vector<vertex> depth_first(const weighted_graph<vertex>& g, const vertex& s
 		if (visited.count(u) == 0){
 			visited.insert(u);
 			df_order.push_back(u);
+			if (order == traversal_order::unordered){
+				for (auto n_it = g.cneighbours_begin(u); n_it != g.cneighbours_end(u); ++n_it){
+					if (visited.count(n_it->first) == 0) unprocessed.push(n_it->first);
+				}
+				continue;
+			}
 			std::priority_queue<vertex> pq;
 			
 			for (auto n_it = g.cneighbours_begin(u); n_it != g.cneighbours_end(u); ++n_it){
@@ -41,7 +60,7 @@ std::vector<vertex> depth_first(const weighted_graph<vertex>& g, const vertex& s
 }
 
 template <typename vertex> 
-std::vector<vertex> breadth_first(const weighted_graph<vertex>& g, const vertex& start_vertex) {
+std::vector<vertex> breadth_first(const weighted_graph<vertex>& g, const vertex& start_vertex, traversal_order order = traversal_order::sorted) {
 
 	std::vector<vertex> bf_order;
 	std::unordered_set<vertex> visited;
@@ -56,6 +75,12 @@ std::vector<vertex> breadth_first(const weighted_graph<vertex>& g, const vertex&
 		if (visited.count(u) == 0){
 			visited.insert(u);
 			bf_order.push_back(u);
+			if (order == traversal_order::unordered){
+				for (auto n_it = g.cneighbours_begin(u); n_it != g.cneighbours_end(u); ++n_it){
+					if (visited.count(n_it->first) == 0) unprocessed.push(n_it->first);
+				}
+				continue;
+			}
 			std::priority_queue<vertex, std::vector<vertex>, std::greater<vertex> > pq;
 			
 			for (auto n_it = g.cneighbours_begin(u); n_it != g.cneighbours_end(u); ++n_it){
@@ -73,4 +98,176 @@ std::vector<vertex> breadth_first(const weighted_graph<vertex>& g, const vertex&
 	return bf_order;
 }
 
+// Visits the vertices of a frozen graph in exactly the order depth_first does with traversal_order::sorted,
+// writing them to df_order. The snapshot already keeps every neighbour list in ascending order, so no
+// step needs to sort anything, and once ws and df_order have grown to fit nothing is allocated either.
+template <typename vertex> 
+void depth_first(const csr_graph<vertex>& g, const vertex& start_vertex, traversal_workspace& ws, std::vector<vertex>& df_order) {
+
+	df_order.clear();
+	if (!g.has_vertex(start_vertex)) return;
+	ws.resize(g.num_vertices());
+	ws.reset();
+	std::vector<int>& unprocessed = ws.frontier;
+	
+	unprocessed.push_back(g.index_of(start_vertex));
+	
+	while (!unprocessed.empty()){
+		
+		int u = unprocessed.back();
+		unprocessed.pop_back();
+		if (ws.mark_seen(u)){
+			df_order.push_back(g.vertex_at(u));
+			// Push in descending order so the smallest neighbour is on top
+			for (auto n_it = g.neighbours_end(u); n_it != g.neighbours_begin(u); --n_it){
+				if (!ws.seen(*(n_it - 1))) unprocessed.push_back(*(n_it - 1));
+			}
+		}
+		
+	}
+	
+}
+
+// Visits the vertices of a frozen graph in exactly the order breadth_first does with traversal_order::sorted,
+// writing them to bf_order.
+template <typename vertex> 
+void breadth_first(const csr_graph<vertex>& g, const vertex& start_vertex, traversal_workspace& ws, std::vector<vertex>& bf_order) {
+
+	bf_order.clear();
+	if (!g.has_vertex(start_vertex)) return;
+	ws.resize(g.num_vertices());
+	ws.reset();
+	// Every vertex is queued at most once, so a plain vector with a moving head can serve as the queue
+	std::vector<int>& queue = ws.frontier;
+	
+	queue.push_back(g.index_of(start_vertex));
+	ws.mark_seen(queue.back());
+	
+	for (int head = 0; head < queue.size(); ++head){
+		int u = queue[head];
+		bf_order.push_back(g.vertex_at(u));
+		for (auto n_it = g.neighbours_begin(u); n_it != g.neighbours_end(u); ++n_it){
+			// Marking on enqueue rather than on visit leaves the order unchanged, as a vertex is visited at its first enqueue either way
+			if (ws.mark_seen(*n_it)) queue.push_back(*n_it);
+		}
+	}
+	
+}
+
+template <typename vertex> 
+std::vector<vertex> depth_first(const csr_graph<vertex>& g, const vertex& start_vertex) {
+	traversal_workspace ws;
+	std::vector<vertex> df_order;
+	depth_first(g, start_vertex, ws, df_order);
+	return df_order;
+}
+
+template <typename vertex> 
+std::vector<vertex> breadth_first(const csr_graph<vertex>& g, const vertex& start_vertex) {
+	traversal_workspace ws;
+	std::vector<vertex> bf_order;
+	breadth_first(g, start_vertex, ws, bf_order);
+	return bf_order;
+}
+
+// A depth or breadth first traversal of a weighted_graph that finds its vertices one at a time,
+// as it is iterated, in the same order as depth_first or breadth_first with the same traversal_order.
+// Breaking out of the loop abandons the rest of the search, and the order is never stored.
+// The graph must outlive the range and must not change while it is being iterated.
+template <typename vertex, bool breadth>
+class traversal_range {
+
+	private:
+
+	const weighted_graph<vertex>* g;
+	traversal_order order;
+	std::unordered_set<vertex> visited;
+	std::deque<vertex> unprocessed; // taken from the front breadth first, and from the back depth first
+	std::vector<vertex> neighbours; // reused for sorting each vertex's neighbours
+	vertex current;
+	bool finished;
+
+	void advance();
+
+	public:
+
+	class iterator {
+		traversal_range* range; // nullptr for the end iterator
+
+		public:
+
+		using iterator_category = std::input_iterator_tag;
+		using value_type = vertex;
+		using difference_type = std::ptrdiff_t;
+		using pointer = const vertex*;
+		using reference = const vertex&;
+
+		explicit iterator(traversal_range* r = nullptr) : range(r) {}
+
+		reference operator*() const { return range->current; }
+		pointer operator->() const { return &range->current; }
+		iterator& operator++() { range->advance(); return *this; }
+		void operator++(int) { range->advance(); }
+		// Every iterator over a finished traversal is equal to end()
+		bool operator==(const iterator& other) const {
+			bool done = range == nullptr || range->finished;
+			bool other_done = other.range == nullptr || other.range->finished;
+			return done == other_done && (done || range == other.range);
+		}
+		bool operator!=(const iterator& other) const { return !(*this == other); }
+	};
+
+	traversal_range(const weighted_graph<vertex>&, const vertex&, traversal_order);
+
+	iterator begin() { return iterator(this); }
+	iterator end() { return iterator(); }
+
+};
+
+template <typename vertex, bool breadth>
+traversal_range<vertex, breadth>::traversal_range(const weighted_graph<vertex>& graph, const vertex& start_vertex, traversal_order o)
+	: g(&graph), order(o), current(start_vertex), finished(!graph.has_vertex(start_vertex)) {
+	if (!finished) visited.insert(start_vertex);
+}
+
+template <typename vertex, bool breadth>
+void traversal_range<vertex, breadth>::advance() {
+	neighbours.clear();
+	for (auto n_it = g->cneighbours_begin(current); n_it != g->cneighbours_end(current); ++n_it){
+		if (visited.count(n_it->first) == 0) neighbours.push_back(n_it->first);
+	}
+	if (order == traversal_order::sorted){
+		// Ascending for the queue; descending for the stack, so that the smallest neighbour is on top
+		if (breadth) std::sort(neighbours.begin(), neighbours.end());
+		else std::sort(neighbours.begin(), neighbours.end(), [](const vertex& a, const vertex& b){ return b < a; });
+	}
+	unprocessed.insert(unprocessed.end(), neighbours.begin(), neighbours.end());
+
+	while (!unprocessed.empty()){
+		vertex u = breadth ? unprocessed.front() : unprocessed.back();
+		if (breadth) unprocessed.pop_front();
+		else unprocessed.pop_back();
+		if (visited.insert(u).second){
+			current = u;
+			return;
+		}
+	}
+	finished = true;
+}
+
+template <typename vertex> using depth_first_range = traversal_range<vertex, false>;
+template <typename vertex> using breadth_first_range = traversal_range<vertex, true>;
+
+// Returns a range over the vertices depth_first would return, found lazily as the range is iterated.
+template <typename vertex>
+depth_first_range<vertex> lazy_depth_first(const weighted_graph<vertex>& g, const vertex& start_vertex, traversal_order order = traversal_order::sorted) {
+	return depth_first_range<vertex>(g, start_vertex, order);
+}
+
+// Returns a range over the vertices breadth_first would return, found lazily as the range is iterated.
+template <typename vertex>
+breadth_first_range<vertex> lazy_breadth_first(const weighted_graph<vertex>& g, const vertex& start_vertex, traversal_order order = traversal_order::sorted) {
+	return breadth_first_range<vertex>(g, start_vertex, order);
+}
+
 #endif
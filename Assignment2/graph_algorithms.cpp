@@ -15,8 +15,13 @@
 #include <utility>
 #include <algorithm>
 #include <limits>
+#include <functional>
 #include "weighted_graph.hpp"
+#include "csr_graph.hpp"
+#include "disjoint_set.hpp"
+#include "traversal_workspace.hpp"
 #include "easy_weighted_graph_algorithms.cpp"
+#include "biconnectivity.cpp"
 
 template <typename vertex>
 bool is_empty(const weighted_graph<vertex>& g) {
@@ -27,37 +32,115 @@ bool is_empty(const weighted_graph<vertex>& g) {
 // Returns true if the graph is connected, false otherwise.
 template <typename vertex>
 bool is_connected(const weighted_graph<vertex>& g){
-	// Return true if the graph is empty, or if a depth first traversal returns every vertex in the graph
-	return is_empty(g) || depth_first(g, *(g.cbegin())).size() == g.num_vertices();
+	// A graph that tracks its own connectivity already knows the answer
+	if (g.tracks_connectivity()) return g.num_components() <= 1;
+	if (is_empty(g)) return true;
+	// Count what a depth first traversal reaches, without keeping the order it reaches it in
+	auto reached = lazy_depth_first(g, *(g.cbegin()), traversal_order::unordered);
+	return std::distance(reached.begin(), reached.end()) == g.num_vertices();
+}
+
+// Returns true if there is a path between u and v, stopping the search as soon as v is reached.
+template <typename vertex>
+bool is_reachable(const weighted_graph<vertex>& g, const vertex& u, const vertex& v){
+	if (!(g.has_vertex(u) && g.has_vertex(v))) return false;
+	if (g.tracks_connectivity()) return g.same_component(u, v);
+	for (const vertex& w : lazy_breadth_first(g, u, traversal_order::unordered)) {
+		if (w == v) return true;
+	}
+	return false;
+}
+
+// A compact labelling of the connected components of a graph.
+// Components are numbered from 0 in the order their first vertex appears in the graph's iteration order.
+template <typename vertex>
+struct component_labelling {
+	std::unordered_map<vertex, int> component; // vertex -> component id
+	std::vector<int> sizes; // number of vertices in each component
+};
+
+// Labels the connected components of g with a union-find, in a single pass over the edges.
+template <typename vertex>
+component_labelling<vertex> component_labels(const weighted_graph<vertex>& g){
+	component_labelling<vertex> labelling;
+	// Number the vertices densely for the union-find; the same map is relabelled with component ids afterwards
+	auto& index = labelling.component;
+	index.reserve(g.num_vertices());
+	for (auto g_it = g.cbegin(); g_it != g.cend(); ++g_it) {
+		index.insert({*g_it, index.size()});
+	}
+	disjoint_set sets(g.num_vertices());
+	for (auto g_it = g.cbegin(); g_it != g.cend(); ++g_it) {
+		int u = index.at(*g_it);
+		for (auto n_it = g.cneighbours_begin(*g_it); n_it != g.cneighbours_end(*g_it); ++n_it) {
+			int w = index.at(n_it->first);
+			if (u < w) sets.unite(u, w);
+		}
+	}
+	// Give each set the next component id the first time one of its vertices comes up
+	std::vector<int> root_label(g.num_vertices(), -1);
+	labelling.sizes.reserve(sets.num_sets());
+	for (auto g_it = g.cbegin(); g_it != g.cend(); ++g_it) {
+		int& label = index.at(*g_it);
+		int root = sets.find(label);
+		if (root_label[root] == -1) {
+			root_label[root] = labelling.sizes.size();
+			labelling.sizes.push_back(0);
+		}
+		label = root_label[root];
+		++labelling.sizes[label];
+	}
+	return labelling;
+}
+
+// Builds one weighted graph per component of the labelling, each reserved to its final size.
+template <typename vertex>
+std::vector<weighted_graph<vertex>> component_subgraphs(const weighted_graph<vertex>& g, const component_labelling<vertex>& labelling){
+	std::vector<weighted_graph<vertex> > components(labelling.sizes.size());
+	for (int i = 0; i < components.size(); ++i) components[i].reserve(labelling.sizes[i]);
+	for (auto g_it = g.cbegin(); g_it != g.cend(); ++g_it) {
+		components[labelling.component.at(*g_it)].add_vertex(*g_it);
+	}
+	for (auto g_it = g.cbegin(); g_it != g.cend(); ++g_it) {
+		vertex u = *g_it;
+		auto& component = components[labelling.component.at(u)];
+		for (auto n_it = g.cneighbours_begin(u); n_it != g.cneighbours_end(u); ++n_it) {
+			// add_edge stores both directions, so only add each edge from its smaller end
+			if (!(n_it->first < u)) component.add_edge(u, n_it->first, n_it->second);
+		}
+	}
+	return components;
 }
 
 // Returns a vector of weighted graphs, where each weighted graph is a connected
 // component of the input graph.
 template <typename vertex>
 std::vector<weighted_graph<vertex>> connected_components(const weighted_graph<vertex>& g){
-	std::vector<weighted_graph<vertex> > components;
-	std::unordered_set<vertex> visited;
-	// For each vertex
-	for (auto g_it = g.cbegin(); g_it != g.cend(); ++g_it) {
-		vertex u = *g_it;
-		// Pick an unvisited vertex
-		if (visited.count(u) == 0) {
-			// Start a traversal at the vertex. All the vertices reached from there form a component
-			auto vertices = depth_first(g, u);
-			// Create a new connected component graph
-			components.push_back(weighted_graph<vertex>());
-			// Mark all vertices as visited and add them to the graph
-			for (auto v : vertices) {
-				components.back().add_vertex(v);
-				visited.insert(v);
-			}
-			// Rebuild all of the vertices' edges
-			for (auto v : vertices) {
-				for (auto n_it = g.cneighbours_begin(v); n_it != g.cneighbours_end(v); ++n_it) {
-					components.back().add_edge(v, n_it->first, n_it->second);
-				}
+	return component_subgraphs(g, component_labels(g));
+}
+
+// Writes the component of every id of the frozen graph g to component, numbered from 0 in ascending
+// order of each component's smallest id, and returns how many components there are.
+// Once ws and component have grown to fit, nothing is allocated.
+template <typename vertex>
+int component_ids(const csr_graph<vertex>& g, traversal_workspace& ws, std::vector<int>& component){
+	component.resize(g.num_vertices());
+	ws.resize(g.num_vertices());
+	ws.reset();
+	int components = 0;
+	for (int s = 0; s < g.num_vertices(); ++s) {
+		if (!ws.mark_seen(s)) continue;
+		// Breadth first over s's component, reusing the frontier as the queue
+		ws.frontier.clear();
+		ws.frontier.push_back(s);
+		for (int head = 0; head < ws.frontier.size(); ++head) {
+			int u = ws.frontier[head];
+			component[u] = components;
+			for (auto n_it = g.neighbours_begin(u); n_it != g.neighbours_end(u); ++n_it) {
+				if (ws.mark_seen(*n_it)) ws.frontier.push_back(*n_it);
 			}
 		}
+		++components;
 	}
 	return components;
 }
@@ -119,26 +202,117 @@ std::map<vertex, int> dijkstras(const weighted_graph<vertex>& g, const vertex& v
 	return dijkstras;
 }
 
+// The heap-based search behind the frozen graph's shortest path queries. Settles the ids of g in
+// ascending order of distance from the id source, asking go_on(id, distance) before settling each
+// one, and stops with it unsettled as soon as the answer is false. Each arc is given the length
+// cost(id, arc) returns, arc being its position in g's arc arrays, and is left out altogether if
+// that is negative; this is how edges and vertices are masked out, or weights reduced by a
+// potential, without copying the graph. What it found is left in ws: ws.frontier lists the settled
+// ids in the order they were settled, ws.distance(id) is final for each of them, and ws.parent(id)
+// gives the shortest path tree. Once ws has grown to fit the graph and the largest heap a query has
+// needed, nothing is allocated, and since resetting ws is O(1) a search that stops early costs only
+// what it explored.
+template <typename vertex, typename F, typename C>
+void shortest_path_ids(const csr_graph<vertex>& g, int source, traversal_workspace& ws, F go_on, C cost){
+	ws.resize(g.num_vertices());
+	ws.reset();
+	if (source < 0 || source >= g.num_vertices()) return;
+	auto& heap = ws.heap;
+	auto later = std::greater<std::pair<int, int>>();
+	ws.set_distance(source, 0, source);
+	heap.push_back({0, source});
+	while (!heap.empty()) {
+		std::pop_heap(heap.begin(), heap.end(), later);
+		int u = heap.back().second;
+		heap.pop_back();
+		// Entries are not removed when a shorter distance is found, so skip the stale ones
+		if (ws.settled(u)) continue;
+		if (!go_on(u, ws.distance(u))) return;
+		ws.settle(u);
+		ws.frontier.push_back(u);
+		for (auto n_it = g.neighbours_begin(u); n_it != g.neighbours_end(u); ++n_it) {
+			int length = cost(u, n_it - g.neighbours_begin(0));
+			if (length < 0) continue;
+			int d = ws.distance(u) + length;
+			if (!ws.settled(*n_it) && d < ws.distance(*n_it)) {
+				ws.set_distance(*n_it, d, u);
+				heap.push_back({d, *n_it});
+				std::push_heap(heap.begin(), heap.end(), later);
+			}
+		}
+	}
+}
+
+// As above, with every arc at its own weight.
+template <typename vertex, typename F>
+void shortest_path_ids(const csr_graph<vertex>& g, int source, traversal_workspace& ws, F go_on){
+	shortest_path_ids(g, source, ws, go_on, [&](int, int arc) { return g.weights_begin(0)[arc]; });
+}
+
+// Finds the distance from the id source to every id of g, leaving them in ws as above: ids source
+// cannot reach are left at the maximum int value.
+template <typename vertex>
+void shortest_path_ids(const csr_graph<vertex>& g, int source, traversal_workspace& ws){
+	shortest_path_ids(g, source, ws, [](int, int) { return true; });
+}
+
+// Finds the distance from v to every id of the frozen graph g, leaving them in ws as above.
+// Uses a binary heap in place of the linear search above.
+template <typename vertex>
+void dijkstras(const csr_graph<vertex>& g, const vertex& v, traversal_workspace& ws){
+	shortest_path_ids(g, g.has_vertex(v) ? g.index_of(v) : -1, ws);
+}
+
+// Writes every vertex of the frozen graph g within distance radius of v to nearby, with its
+// distance, in ascending order of distance and starting with v itself. Only the region within the
+// radius is explored, so with a reused ws the cost does not grow with the size of the graph.
+template <typename vertex>
+void dijkstras_within(const csr_graph<vertex>& g, const vertex& v, int radius, traversal_workspace& ws, std::vector<std::pair<vertex, int>>& nearby){
+	nearby.clear();
+	shortest_path_ids(g, g.has_vertex(v) ? g.index_of(v) : -1, ws, [&](int, int d) { return d <= radius; });
+	for (int u : ws.frontier) nearby.push_back({g.vertex_at(u), ws.distance(u)});
+}
+
+// Writes the k vertices of the frozen graph g nearest to v to nearest, with their distances, in
+// ascending order of distance; v itself comes first, at distance 0. Fewer are written if fewer can
+// be reached, and none if k is not positive. Vertices tied with the k-th are left out, whichever
+// the heap settles first being kept.
+template <typename vertex>
+void k_nearest(const csr_graph<vertex>& g, const vertex& v, int k, traversal_workspace& ws, std::vector<std::pair<vertex, int>>& nearest){
+	nearest.clear();
+	if (k <= 0) return;
+	shortest_path_ids(g, g.has_vertex(v) ? g.index_of(v) : -1, ws, [&](int, int) { return static_cast<int>(ws.frontier.size()) < k; });
+	for (int u : ws.frontier) nearest.push_back({g.vertex_at(u), ws.distance(u)});
+}
+
+// The breadth first counterpart of shortest_path_ids, counting every edge as one step whatever its
+// weight. Leaves the same things in ws, with ws.frontier in the order the ids were dequeued.
+template <typename vertex>
+void hop_distance_ids(const csr_graph<vertex>& g, int source, traversal_workspace& ws){
+	ws.resize(g.num_vertices());
+	ws.reset();
+	if (source < 0 || source >= g.num_vertices()) return;
+	auto& queue = ws.frontier;
+	ws.set_distance(source, 0, source);
+	ws.settle(source);
+	queue.push_back(source);
+	for (int head = 0; head < queue.size(); ++head) {
+		int u = queue[head];
+		for (auto n_it = g.neighbours_begin(u); n_it != g.neighbours_end(u); ++n_it) {
+			if (ws.settled(*n_it)) continue;
+			ws.set_distance(*n_it, ws.distance(u) + 1, u);
+			ws.settle(*n_it);
+			queue.push_back(*n_it);
+		}
+	}
+}
+
 // Returns a vector containing all the articulation points of the
 // input weighted graph g.
 template <typename vertex>
 std::vector<vertex> articulation_points(const weighted_graph<vertex>& g){
-	std::vector<vertex> articulation_points;
-	weighted_graph<vertex> test_graph; // Make a copy of the graph to test with.
-	// Simple, but O(n^2) time complexity approach. 
-	for (auto g_it = g.cbegin(); g_it != g.cend(); ++g_it) {
-		// Reset the test graph
-		test_graph = g;
-		vertex v = *g_it;
-		// Remove the vertex from the graph
-		test_graph.remove_vertex(v);
-		// If the graph is no longer connected
-		if (!is_connected(test_graph)) {
-			// The vertex is an articulation point
-			articulation_points.push_back(v);
-		}
-	}
-	return articulation_points;
+	// A single linear-time low-link pass finds every articulation point at once
+	return biconnected_components(g).articulation_points;
 }
 
 #endif
@@ -0,0 +1,231 @@
+#ifndef GRAPH_COLORING
+#define GRAPH_COLORING
+
+#include <vector>
+#include <atomic>
+#include <random>
+#include <numeric>
+#include <algorithm>
+#include <stdexcept>
+#include "weighted_graph.hpp"
+#include "csr_graph.hpp"
+#include "thread_pool.hpp"
+#include "core_decomposition.cpp"
+
+// The order greedy coloring takes the vertices in. Largest degree first colors the vertices with
+// the most neighbours while they still have the most colors to choose from. Smallest last colors
+// them in the reverse of the order a k-core peeling removes them in, so each vertex has at most
+// the degeneracy's worth of colored neighbours when its turn comes, and at most degeneracy + 1
+// colors are used. It tends to use fewer colors, but makes longer chains of vertices that have
+// to wait for each other.
+enum class coloring_order { largest_degree_first, smallest_last };
+
+// How the colors are chosen: one vertex at a time, by Jones and Plassmann's method, which colors
+// every vertex whose earlier neighbours are all colored at once, or speculatively, coloring every
+// vertex at once and recoloring those that clash until none do.
+enum class coloring_method { greedy, jones_plassmann, speculative };
+
+// Returns a priority for every id of c, a permutation of 0..n-1 with the ids to be colored first
+// highest. Ids of equal degree are ordered at random by seed rather than by id, so that Jones and
+// Plassmann's method does not end up waiting along long runs of consecutive ids.
+template <typename vertex>
+std::vector<int> coloring_priorities(const csr_graph<vertex>& c, coloring_order order, unsigned seed = 0) {
+	const int n = c.num_vertices();
+	std::vector<int> by_priority(n);
+	if (order == coloring_order::smallest_last) {
+		std::vector<int> core;
+		core_number_ids(c, core, by_priority);
+	} else {
+		std::iota(by_priority.begin(), by_priority.end(), 0);
+		std::mt19937 rng(seed);
+		std::shuffle(by_priority.begin(), by_priority.end(), rng);
+		std::stable_sort(by_priority.begin(), by_priority.end(), [&](int a, int b) { return c.degree(a) < c.degree(b); });
+	}
+	std::vector<int> priority(n);
+	for (int i = 0; i < n; ++i) priority[by_priority[i]] = i;
+	return priority;
+}
+
+// Returns the largest degree of any id of c.
+template <typename vertex>
+int max_degree(const csr_graph<vertex>& c) {
+	int widest = 0;
+	for (int u = 0; u < c.num_vertices(); ++u) widest = std::max(widest, c.degree(u));
+	return widest;
+}
+
+// Returns the smallest color no neighbour of u has, ignoring uncolored (-1) neighbours. Taken
+// colors are marked in mark with stamp, which must differ from every stamp used before with the
+// same mark; mark needs room for one more color than u has neighbours.
+template <typename vertex, typename C>
+int smallest_free_color(const csr_graph<vertex>& c, int u, const C& color, std::vector<int>& mark, int stamp) {
+	for (auto n_it = c.neighbours_begin(u); n_it != c.neighbours_end(u); ++n_it) {
+		int k = color[*n_it];
+		if (k >= 0 && k < mark.size()) mark[k] = stamp;
+	}
+	int k = 0;
+	while (mark[k] == stamp) ++k;
+	return k;
+}
+
+// Returns the color of every id of c, colored one at a time from the highest priority down, each
+// with the smallest color none of its neighbours has.
+template <typename vertex>
+std::vector<int> greedy_coloring_ids(const csr_graph<vertex>& c, const std::vector<int>& priority) {
+	const int n = c.num_vertices();
+	std::vector<int> by_priority(n);
+	for (int u = 0; u < n; ++u) by_priority[n - 1 - priority[u]] = u;
+	std::vector<int> color(n, -1);
+	std::vector<int> mark(max_degree(c) + 1, -1);
+	for (int u : by_priority) color[u] = smallest_free_color(c, u, color, mark, u);
+	return color;
+}
+
+// Returns the same coloring as greedy_coloring_ids, colored in parallel (Jones and Plassmann), and
+// writes how many rounds it took to rounds. Every id waits on its neighbours of higher priority:
+// the ids with none are colored together in the first round, and whichever worker colors the last
+// neighbour an id is waiting on hands it to the next round. An id is only colored once all of its
+// earlier neighbours are, so it picks exactly the color the sequential pass would.
+template <typename vertex>
+std::vector<int> jones_plassmann_ids(const csr_graph<vertex>& c, const std::vector<int>& priority, thread_pool& pool, int& rounds) {
+	const int n = c.num_vertices();
+	std::vector<int> color(n, -1);
+	std::vector<std::atomic<int>> waiting(n);
+	std::vector<std::vector<int>> marks(pool.size(), std::vector<int>(max_degree(c) + 1, -1));
+	std::vector<std::vector<int>> local(pool.size());
+	pool.parallel_for(0, n, 1024, [&](int begin, int end, int worker) {
+		for (int u = begin; u < end; ++u) {
+			int earlier = 0;
+			for (auto n_it = c.neighbours_begin(u); n_it != c.neighbours_end(u); ++n_it) earlier += priority[*n_it] > priority[u];
+			waiting[u].store(earlier, std::memory_order_relaxed);
+			if (earlier == 0) local[worker].push_back(u);
+		}
+	});
+
+	std::vector<int> batch;
+	rounds = 0;
+	while (true) {
+		batch.clear();
+		for (auto& l : local) {
+			batch.insert(batch.end(), l.begin(), l.end());
+			l.clear();
+		}
+		if (batch.empty()) break;
+		++rounds;
+		pool.parallel_for(0, batch.size(), 64, [&](int begin, int end, int worker) {
+			for (int i = begin; i < end; ++i) {
+				int u = batch[i];
+				color[u] = smallest_free_color(c, u, color, marks[worker], u);
+				for (auto n_it = c.neighbours_begin(u); n_it != c.neighbours_end(u); ++n_it) {
+					if (priority[*n_it] < priority[u] && waiting[*n_it].fetch_sub(1, std::memory_order_relaxed) == 1) local[worker].push_back(*n_it);
+				}
+			}
+		});
+	}
+	return color;
+}
+
+// Returns a coloring of c made speculatively, and writes how many rounds it took to rounds. Every
+// uncolored id is given the smallest color free among its neighbours' current colors at once,
+// though a neighbour may be choosing at the same moment. Each id that then shares a color with a
+// neighbour of higher priority is recolored in the next round. The id of highest priority left never
+// loses, so every round colors at least one for good; in practice nearly all of them.
+template <typename vertex>
+std::vector<int> speculative_coloring_ids(const csr_graph<vertex>& c, const std::vector<int>& priority, thread_pool& pool, int& rounds) {
+	const int n = c.num_vertices();
+	std::vector<std::atomic<int>> color(n);
+	std::vector<std::vector<int>> marks(pool.size(), std::vector<int>(max_degree(c) + 1, -1));
+	std::vector<int> stamps(pool.size(), 0);
+	std::vector<std::vector<int>> local(pool.size());
+	std::vector<int> pending(n);
+	for (int u = 0; u < n; ++u) pending[n - 1 - priority[u]] = u;
+	pool.parallel_for(0, n, 4096, [&](int begin, int end, int) {
+		for (int u = begin; u < end; ++u) color[u].store(-1, std::memory_order_relaxed);
+	});
+
+	// Reads the colors through relaxed loads, since neighbours may be writing theirs
+	struct current {
+		const std::vector<std::atomic<int>>& color;
+		int operator[](int u) const { return color[u].load(std::memory_order_relaxed); }
+	} colors{color};
+
+	rounds = 0;
+	while (!pending.empty()) {
+		++rounds;
+		pool.parallel_for(0, pending.size(), 64, [&](int begin, int end, int worker) {
+			for (int i = begin; i < end; ++i) {
+				int u = pending[i];
+				color[u].store(smallest_free_color(c, u, colors, marks[worker], stamps[worker]++), std::memory_order_relaxed);
+			}
+		});
+		pool.parallel_for(0, pending.size(), 256, [&](int begin, int end, int worker) {
+			for (int i = begin; i < end; ++i) {
+				int u = pending[i];
+				for (auto n_it = c.neighbours_begin(u); n_it != c.neighbours_end(u); ++n_it) {
+					if (colors[*n_it] == colors[u] && priority[*n_it] > priority[u]) {
+						local[worker].push_back(u);
+						break;
+					}
+				}
+			}
+		});
+		pending.clear();
+		for (auto& l : local) {
+			pending.insert(pending.end(), l.begin(), l.end());
+			l.clear();
+		}
+		std::sort(pending.begin(), pending.end(), [&](int a, int b) { return priority[a] > priority[b]; });
+	}
+
+	std::vector<int> result(n);
+	for (int u = 0; u < n; ++u) result[u] = colors[u];
+	return result;
+}
+
+// Returns true if no two adjacent ids of c have the same color.
+template <typename vertex>
+bool is_proper_coloring(const csr_graph<vertex>& c, const std::vector<int>& color) {
+	for (int u = 0; u < c.num_vertices(); ++u) {
+		if (color[u] < 0) return false;
+		for (auto n_it = c.neighbours_begin(u); n_it != c.neighbours_end(u); ++n_it) {
+			if (color[*n_it] == color[u]) return false;
+		}
+	}
+	return true;
+}
+
+// A coloring of the vertices of a graph, where adjacent vertices never share a color. Colors are
+// kept in a dense array by the ids of the graph's csr_graph, which number the vertices in ascending order.
+template <typename vertex>
+struct graph_coloring {
+	std::vector<vertex> vertices; // id -> vertex, in ascending order
+	std::vector<int> color; // id -> color, numbered from 0
+	int colors = 0; // how many colors were used
+	int rounds = 0; // how many parallel rounds it took, 0 for the sequential greedy coloring
+	// Returns the color of u. Throws std::out_of_range if u was not colored.
+	int color_of(const vertex& u) const {
+		auto v_it = std::lower_bound(vertices.begin(), vertices.end(), u);
+		if (v_it == vertices.end() || *v_it != u) throw std::out_of_range("vertex not colored");
+		return color[v_it - vertices.begin()];
+	}
+};
+
+// Colors the vertices of g so that no two adjacent vertices share a color, by the given method and order.
+template <typename vertex>
+graph_coloring<vertex> color_graph(const weighted_graph<vertex>& g, thread_pool& pool,
+	coloring_method method = coloring_method::jones_plassmann, coloring_order order = coloring_order::largest_degree_first, unsigned seed = 0) {
+	csr_graph<vertex> c(g);
+	std::vector<int> priority = coloring_priorities(c, order, seed);
+	graph_coloring<vertex> result;
+	if (method == coloring_method::greedy) result.color = greedy_coloring_ids(c, priority);
+	else if (method == coloring_method::jones_plassmann) result.color = jones_plassmann_ids(c, priority, pool, result.rounds);
+	else result.color = speculative_coloring_ids(c, priority, pool, result.rounds);
+	result.vertices.reserve(c.num_vertices());
+	for (int u = 0; u < c.num_vertices(); ++u) {
+		result.vertices.push_back(c.vertex_at(u));
+		result.colors = std::max(result.colors, result.color[u] + 1);
+	}
+	return result;
+}
+
+#endif
@@ -0,0 +1,23 @@
+#ifndef GRAPH_OBSERVER_H
+#define GRAPH_OBSERVER_H
+
+// Receives a callback after every change made to a weighted_graph it has been attached to,
+// so that structures derived from the graph can keep themselves up to date.
+// Removing a vertex reports the removal of each of its edges first, one at a time and each once it
+// is gone from both ends, then the vertex itself.
+template <typename vertex>
+class graph_observer {
+
+	public:
+
+	virtual ~graph_observer() {}
+
+	virtual void vertex_added(const vertex&) {}
+	virtual void vertex_removed(const vertex&) {}
+	virtual void edge_added(const vertex&, const vertex&, int) {}
+	virtual void edge_removed(const vertex&, const vertex&, int) {}
+	virtual void edge_weight_changed(const vertex&, const vertex&, int, int) {} // old weight, then new weight
+
+};
+
+#endif
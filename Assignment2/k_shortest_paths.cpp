@@ -0,0 +1,117 @@
+#ifndef K_SHORTEST_PATHS
+#define K_SHORTEST_PATHS
+
+#include <set>
+#include <vector>
+#include <limits>
+#include <utility>
+#include <iterator>
+#include <algorithm>
+#include "weighted_graph.hpp"
+#include "csr_graph.hpp"
+#include "traversal_workspace.hpp"
+#include "graph_algorithms.cpp"
+
+// A path through a graph, and its length: the sum of the weights of its edges.
+template <typename vertex>
+struct weighted_path {
+	int length = 0;
+	std::vector<vertex> vertices; // from the first vertex to the last
+};
+
+// Writes the k shortest loopless paths from the id source to the id target of c to paths, shortest
+// first, or as many as there are (Yen). Returns how many spur searches that took.
+// Each path after the first leaves an earlier one at some spur vertex: it shares the earlier path's
+// root up to the spur, and then avoids the root's other vertices and every edge the paths found so
+// far with the same root took out of the spur. Those are masked out by stamps rather than removed
+// from the graph. One search from the target first gives every vertex near it its distance to it,
+// which masking can only lengthen, so each spur search runs on weights reduced by those distances
+// and heads straight for the target, like A* with an exact heuristic. The same bound
+// prunes candidates: only the k - found shortest are kept, and a spur whose root and best possible
+// remainder could not beat the longest of them is not searched at all, nor is any search carried
+// past that length.
+template <typename vertex>
+int k_shortest_path_ids(const csr_graph<vertex>& c, int source, int target, int k, traversal_workspace& ws, std::vector<weighted_path<int>>& paths) {
+	paths.clear();
+	const int n = c.num_vertices();
+	const int infinity = std::numeric_limits<int>::max();
+	if (k <= 0 || source < 0 || source >= n || target < 0 || target >= n) return 0;
+
+	// Only as far out from the target as the source: any further, the source's distance is as good
+	// a lower bound, and still one the reduced weights stay non-negative under
+	shortest_path_ids(c, target, ws, [&](int, int) { return !ws.settled(source); });
+	if (!ws.settled(source)) return 0;
+	std::vector<int> to_target(n, ws.distance(source));
+	for (int u : ws.frontier) to_target[u] = ws.distance(u);
+	// The first path follows the search's tree from the source back to the target
+	paths.push_back({to_target[source], {}});
+	for (int u = source; ; u = ws.parent(u)) {
+		paths[0].vertices.push_back(u);
+		if (u == target) break;
+	}
+
+	const int* target_of = c.neighbours_begin(0);
+	const int* weight = c.weights_begin(0);
+	auto arc_between = [&](int u, int v) { return std::lower_bound(c.neighbours_begin(u), c.neighbours_end(u), v) - target_of; };
+	std::vector<unsigned> vertex_mask(n, 0), arc_mask(c.num_arcs(), 0);
+	unsigned stamp = 0;
+	std::set<std::pair<int, std::vector<int>>> candidates; // (length, path), which also drops duplicates
+	int searches = 0;
+
+	while (paths.size() < k) {
+		const std::vector<int> last = paths.back().vertices;
+		const int wanted = k - paths.size();
+		int root_length = 0;
+		for (int i = 0; i + 1 < last.size(); ++i) {
+			int spur = last[i];
+			int bound = candidates.size() >= wanted ? std::prev(candidates.end())->first : infinity;
+			if (root_length + to_target[spur] < bound) {
+				++stamp;
+				for (int j = 0; j < i; ++j) vertex_mask[last[j]] = stamp;
+				for (const auto& p : paths) {
+					if (p.vertices.size() > i + 1 && std::equal(last.begin(), last.begin() + i + 1, p.vertices.begin())) arc_mask[arc_between(spur, p.vertices[i + 1])] = stamp;
+				}
+				// Reduced distances: what a path through u adds to the shortest possible from the spur
+				int slack = bound == infinity ? infinity : bound - root_length - to_target[spur];
+				++searches;
+				shortest_path_ids(c, spur, ws,
+					[&](int, int d) { return !ws.settled(target) && d < slack; },
+					[&](int u, int arc) {
+						int v = target_of[arc];
+						if (vertex_mask[v] == stamp || arc_mask[arc] == stamp) return -1;
+						return weight[arc] + to_target[v] - to_target[u];
+					});
+				if (ws.settled(target)) {
+					std::vector<int> path(last.begin(), last.begin() + i);
+					for (int u = target; u != spur; u = ws.parent(u)) path.push_back(u);
+					path.push_back(spur);
+					std::reverse(path.begin() + i, path.end());
+					candidates.insert({root_length + to_target[spur] + ws.distance(target), path});
+					while (candidates.size() > wanted) candidates.erase(std::prev(candidates.end()));
+				}
+			}
+			root_length += weight[arc_between(spur, last[i + 1])];
+		}
+		if (candidates.empty()) break;
+		paths.push_back({candidates.begin()->first, candidates.begin()->second});
+		candidates.erase(candidates.begin());
+	}
+	return searches;
+}
+
+// Returns the k shortest loopless paths from u to v in g, shortest first, or as many as there are.
+template <typename vertex>
+std::vector<weighted_path<vertex>> k_shortest_paths(const weighted_graph<vertex>& g, const vertex& u, const vertex& v, int k) {
+	csr_graph<vertex> c(g);
+	traversal_workspace ws(c.num_vertices());
+	std::vector<weighted_path<int>> found;
+	if (c.has_vertex(u) && c.has_vertex(v)) k_shortest_path_ids(c, c.index_of(u), c.index_of(v), k, ws, found);
+	std::vector<weighted_path<vertex>> paths;
+	for (const auto& p : found) {
+		paths.push_back({p.length, {}});
+		for (int id : p.vertices) paths.back().vertices.push_back(c.vertex_at(id));
+	}
+	return paths;
+}
+
+#endif
@@ -0,0 +1,184 @@
+#ifndef LABEL_PROPAGATION
+#define LABEL_PROPAGATION
+
+#include <vector>
+#include <atomic>
+#include <random>
+#include <numeric>
+#include <utility>
+#include <algorithm>
+#include <unordered_map>
+#include "weighted_graph.hpp"
+#include "csr_graph.hpp"
+#include "thread_pool.hpp"
+
+// Settings for label_propagation.
+struct label_propagation_options {
+	unsigned seed = 0; // fixes the visiting order and how ties between labels are broken
+	double threshold = 0.0001; // stop once fewer than this fraction of the vertices change label in a round
+	int max_rounds = 100;
+	bool split_disconnected = true; // give each connected piece of a community a label of its own
+};
+
+// A partition of the vertices of a graph into communities.
+template <typename vertex>
+struct community_partition {
+	std::unordered_map<vertex, int> community; // vertex -> community, numbered from 0
+	std::vector<int> sizes; // number of vertices in each community
+	int rounds = 0; // how many rounds of propagation it took
+};
+
+// Scrambles a label with the seed and the round, so ties go a different way each round but the
+// same way every time the same seed is used.
+inline unsigned tie_break(int label, unsigned seed, int round) {
+	unsigned long long x = (static_cast<unsigned long long>(label) << 32) ^ (seed * 0x9e3779b97f4a7c15ULL) ^ round;
+	x ^= x >> 33;
+	x *= 0xff51afd7ed558ccdULL;
+	x ^= x >> 33;
+	return x;
+}
+
+// Labels every id of c with its community by asynchronous label propagation, and returns how many
+// rounds it took. Every id starts in a community of its own. In each round the ids are visited in a
+// seeded random order and each moves to the label carrying the most edge weight among its
+// neighbours, keeping its own label on a tie. Labels are read and written in place while the round
+// is under way, so a move is seen by the ids visited after it; that asynchrony is what stops two
+// halves of a bipartite graph from swapping labels back and forth forever. Only ids with a
+// neighbour that moved are looked at again. Each worker collects its neighbours' labels into a
+// buffer of its own and sorts it to total them. With a pool of one, the result depends only on the
+// seed; with more, it also depends on how the workers' updates happen to interleave.
+template <typename vertex>
+int label_propagation_ids(const csr_graph<vertex>& c, thread_pool& pool, const label_propagation_options& options, std::vector<int>& label) {
+	const int n = c.num_vertices();
+	std::vector<std::atomic<int>> current(n);
+	std::vector<std::atomic<char>> active(n);
+	std::vector<int> order(n);
+	pool.parallel_for(0, n, 4096, [&](int begin, int end, int) {
+		for (int u = begin; u < end; ++u) {
+			current[u].store(u, std::memory_order_relaxed);
+			active[u].store(true, std::memory_order_relaxed);
+			order[u] = u;
+		}
+	});
+
+	std::mt19937 rng(options.seed);
+	std::vector<std::vector<std::pair<int, int>>> buffers(pool.size()); // (label, weight) per worker
+	std::vector<long long> moved(pool.size());
+	int rounds = 0;
+	while (rounds < options.max_rounds) {
+		std::shuffle(order.begin(), order.end(), rng);
+		std::fill(moved.begin(), moved.end(), 0);
+		pool.parallel_for(0, n, 1024, [&](int begin, int end, int worker) {
+			auto& around = buffers[worker];
+			for (int i = begin; i < end; ++i) {
+				int u = order[i];
+				if (!active[u].exchange(false, std::memory_order_relaxed)) continue;
+				around.clear();
+				auto w = c.weights_begin(u);
+				for (auto n_it = c.neighbours_begin(u); n_it != c.neighbours_end(u); ++n_it, ++w) {
+					around.push_back({current[*n_it].load(std::memory_order_relaxed), *w});
+				}
+				if (around.empty()) continue;
+				std::sort(around.begin(), around.end());
+
+				int own = current[u].load(std::memory_order_relaxed);
+				int best = own;
+				long long best_weight = -1;
+				for (int j = 0; j < around.size();) {
+					int l = around[j].first;
+					long long total = 0;
+					for (; j < around.size() && around[j].first == l; ++j) total += around[j].second;
+					bool better = total > best_weight;
+					if (total == best_weight) {
+						better = l == own || (best != own && tie_break(l, options.seed, rounds) < tie_break(best, options.seed, rounds));
+					}
+					if (better) {
+						best = l;
+						best_weight = total;
+					}
+				}
+				if (best == own) continue;
+				current[u].store(best, std::memory_order_relaxed);
+				++moved[worker];
+				for (auto n_it = c.neighbours_begin(u); n_it != c.neighbours_end(u); ++n_it) active[*n_it].store(true, std::memory_order_relaxed);
+			}
+		});
+		++rounds;
+		if (std::accumulate(moved.begin(), moved.end(), 0LL) <= options.threshold * n) break;
+	}
+
+	label.resize(n);
+	for (int u = 0; u < n; ++u) label[u] = current[u].load(std::memory_order_relaxed);
+	return rounds;
+}
+
+// Gives every connected piece of each community of label a label of its own, the id it was first
+// reached from, by a search that only follows edges within a community.
+template <typename vertex>
+void split_disconnected_communities(const csr_graph<vertex>& c, std::vector<int>& label) {
+	const int n = c.num_vertices();
+	std::vector<int> piece(n, -1);
+	std::vector<int> stack;
+	for (int root = 0; root < n; ++root) {
+		if (piece[root] != -1) continue;
+		piece[root] = root;
+		stack.push_back(root);
+		while (!stack.empty()) {
+			int u = stack.back();
+			stack.pop_back();
+			for (auto n_it = c.neighbours_begin(u); n_it != c.neighbours_end(u); ++n_it) {
+				if (piece[*n_it] == -1 && label[*n_it] == label[u]) {
+					piece[*n_it] = root;
+					stack.push_back(*n_it);
+				}
+			}
+		}
+	}
+	label.swap(piece);
+}
+
+// Divides the vertices of g into communities by weighted label propagation. Communities are
+// numbered from 0 in the order their first vertex appears in the graph's iteration order.
+template <typename vertex>
+community_partition<vertex> label_propagation(const weighted_graph<vertex>& g, thread_pool& pool, const label_propagation_options& options = {}) {
+	csr_graph<vertex> c(g);
+	std::vector<int> label;
+	community_partition<vertex> result;
+	result.rounds = label_propagation_ids(c, pool, options, label);
+	if (options.split_disconnected) split_disconnected_communities(c, label);
+
+	std::vector<int> number(c.num_vertices(), -1);
+	result.community.reserve(c.num_vertices());
+	for (auto g_it = g.cbegin(); g_it != g.cend(); ++g_it) {
+		int& community = number[label[c.index_of(*g_it)]];
+		if (community == -1) {
+			community = result.sizes.size();
+			result.sizes.push_back(0);
+		}
+		result.community[*g_it] = community;
+		++result.sizes[community];
+	}
+	return result;
+}
+
+// Returns the modularity of a partition of g: the fraction of the edge weight that falls within
+// communities, less the fraction expected if the edges were rewired at random keeping every degree.
+template <typename vertex>
+double modularity(const weighted_graph<vertex>& g, const std::unordered_map<vertex, int>& community) {
+	double total = 0, within = 0;
+	std::unordered_map<int, double> degree; // community -> total weighted degree
+	for (auto g_it = g.cbegin(); g_it != g.cend(); ++g_it) {
+		int own = community.at(*g_it);
+		for (auto n_it = g.cneighbours_begin(*g_it); n_it != g.cneighbours_end(*g_it); ++n_it) {
+			total += n_it->second;
+			degree[own] += n_it->second;
+			if (community.at(n_it->first) == own) within += n_it->second;
+		}
+	}
+	if (total == 0) return 0;
+	double expected = 0;
+	for (const auto& d : degree) expected += (d.second / total) * (d.second / total);
+	return within / total - expected;
+}
+
+#endif
@@ -0,0 +1,149 @@
+#ifndef MINIMUM_SPANNING_FOREST
+#define MINIMUM_SPANNING_FOREST
+
+#include <vector>
+#include <queue>
+#include <utility>
+#include <algorithm>
+#include "weighted_graph.hpp"
+#include "csr_graph.hpp"
+#include "disjoint_set.hpp"
+#include "thread_pool.hpp"
+
+// An edge of a spanning forest.
+template <typename vertex>
+struct weighted_edge {
+	vertex u;
+	vertex v;
+	int weight;
+};
+
+// An edge between dense ids of a csr_graph, ordered by weight and then by its ends.
+struct id_edge {
+	int weight;
+	int u;
+	int v;
+	bool operator<(const id_edge& other) const {
+		if (weight != other.weight) return weight < other.weight;
+		return u != other.u ? u < other.u : v < other.v;
+	}
+};
+
+// Every edge of c once, with u < v.
+template <typename vertex>
+std::vector<id_edge> id_edges(const csr_graph<vertex>& c) {
+	std::vector<id_edge> edges;
+	edges.reserve(c.num_edges());
+	for (int u = 0; u < c.num_vertices(); ++u) {
+		auto w = c.weights_begin(u);
+		for (auto n_it = c.neighbours_begin(u); n_it != c.neighbours_end(u); ++n_it, ++w) {
+			if (u < *n_it) edges.push_back({*w, u, *n_it});
+		}
+	}
+	return edges;
+}
+
+// Adds the edges of [first, last) that join two trees of sets to forest, lightest first (Filter-Kruskal).
+// Instead of sorting every edge up front, the range is split around a pivot weight like a quicksort:
+// the light side is handled first, and by the time the heavy side is reached many of its edges join
+// vertices that are already in one tree, so they are filtered out rather than sorted. Ranges small
+// enough are sorted outright and run through plain Kruskal; the more workers there are to sort
+// them in parallel, the larger those ranges are allowed to be.
+template <typename iterator>
+void filter_kruskal(iterator first, iterator last, disjoint_set& sets, std::vector<id_edge>& forest, thread_pool& pool) {
+	const int kruskal_threshold = 4096 * pool.size();
+	if (first == last || forest.size() + 1 == sets.size()) return;
+	if (last - first <= kruskal_threshold) {
+		parallel_sort(first, last, pool);
+		for (auto e = first; e != last; ++e) {
+			if (sets.unite(e->u, e->v)) forest.push_back(*e);
+		}
+		return;
+	}
+
+	// Median of three, so ranges that arrive partly sorted still split evenly
+	int a = first->weight, b = (first + (last - first) / 2)->weight, c = (last - 1)->weight;
+	int pivot = std::max(std::min(a, b), std::min(std::max(a, b), c));
+	auto light_end = std::partition(first, last, [&](const id_edge& e) { return e.weight < pivot; });
+	auto equal_end = std::partition(light_end, last, [&](const id_edge& e) { return e.weight == pivot; });
+
+	filter_kruskal(first, light_end, sets, forest, pool);
+	// Edges of equal weight can go in any order; sorting them only keeps the result deterministic
+	parallel_sort(light_end, equal_end, pool);
+	for (auto e = light_end; e != equal_end; ++e) {
+		if (sets.unite(e->u, e->v)) forest.push_back(*e);
+	}
+	auto heavy_end = std::partition(equal_end, last, [&](const id_edge& e) { return !sets.same_set(e.u, e.v); });
+	filter_kruskal(equal_end, heavy_end, sets, forest, pool);
+}
+
+// Returns the edges of a minimum spanning forest of c by dense id, a spanning tree of each
+// connected component, in ascending order of weight.
+template <typename vertex>
+std::vector<id_edge> minimum_spanning_forest_ids(const csr_graph<vertex>& c, thread_pool& pool) {
+	std::vector<id_edge> edges = id_edges(c);
+	disjoint_set sets(c.num_vertices());
+	std::vector<id_edge> forest;
+	forest.reserve(std::max(0, c.num_vertices() - 1));
+	filter_kruskal(edges.begin(), edges.end(), sets, forest, pool);
+	return forest;
+}
+
+// Returns the edges of a minimum spanning forest of g, lightest first.
+template <typename vertex>
+std::vector<weighted_edge<vertex>> minimum_spanning_forest_edges(const weighted_graph<vertex>& g, thread_pool& pool) {
+	csr_graph<vertex> c(g);
+	std::vector<weighted_edge<vertex>> edges;
+	for (const id_edge& e : minimum_spanning_forest_ids(c, pool)) edges.push_back({c.vertex_at(e.u), c.vertex_at(e.v), e.weight});
+	return edges;
+}
+
+// Returns a minimum spanning forest of g as a graph with every vertex of g.
+template <typename vertex>
+weighted_graph<vertex> minimum_spanning_forest(const weighted_graph<vertex>& g, thread_pool& pool) {
+	weighted_graph<vertex> forest;
+	forest.reserve(g.num_vertices());
+	for (auto g_it = g.cbegin(); g_it != g.cend(); ++g_it) forest.add_vertex(*g_it);
+	for (const auto& e : minimum_spanning_forest_edges(g, pool)) forest.add_edge(e.u, e.v, e.weight);
+	return forest;
+}
+
+// As above, on the calling thread alone.
+template <typename vertex>
+weighted_graph<vertex> minimum_spanning_forest(const weighted_graph<vertex>& g) {
+	thread_pool pool(1);
+	return minimum_spanning_forest(g, pool);
+}
+
+// Returns the edges of a minimum spanning forest of c by dense id using Prim's algorithm with a
+// binary heap, growing a tree from the smallest id of every component in turn.
+// Kept as the baseline Filter-Kruskal is measured against.
+template <typename vertex>
+std::vector<id_edge> prim_spanning_forest_ids(const csr_graph<vertex>& c) {
+	const int n = c.num_vertices();
+	std::vector<id_edge> forest;
+	std::vector<char> in_tree(n, false);
+	struct heavier {
+		bool operator()(const id_edge& a, const id_edge& b) const { return b < a; }
+	};
+	// Edges from the tree grown so far (u) to vertices outside it (v), lightest on top
+	std::priority_queue<id_edge, std::vector<id_edge>, heavier> leaving;
+	for (int root = 0; root < n; ++root) {
+		if (in_tree[root]) continue;
+		leaving.push({0, root, root});
+		while (!leaving.empty()) {
+			id_edge e = leaving.top();
+			leaving.pop();
+			if (in_tree[e.v]) continue;
+			in_tree[e.v] = true;
+			if (e.u != e.v) forest.push_back(e.u < e.v ? e : id_edge{e.weight, e.v, e.u});
+			auto w = c.weights_begin(e.v);
+			for (auto n_it = c.neighbours_begin(e.v); n_it != c.neighbours_end(e.v); ++n_it, ++w) {
+				if (!in_tree[*n_it]) leaving.push({*w, e.v, *n_it});
+			}
+		}
+	}
+	return forest;
+}
+
+#endif
@@ -0,0 +1,128 @@
+#ifndef MULTI_SOURCE_BFS
+#define MULTI_SOURCE_BFS
+
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+#include "weighted_graph.hpp"
+#include "csr_graph.hpp"
+
+// What a breadth first search from one source finds, without the distances themselves.
+struct bfs_summary {
+	int reached = 0; // vertices reachable from the source, including itself
+	long long total_distance = 0; // sum of the hop distances to every reached vertex
+	int eccentricity = 0; // hop distance to the furthest reached vertex
+	double closeness() const { return total_distance == 0 ? 0 : double(reached - 1) / total_distance; }
+};
+
+// Index of the lowest set bit of a non-zero word.
+inline int lowest_bit(std::uint64_t bits) {
+#if defined(__GNUC__)
+	return __builtin_ctzll(bits);
+#else
+	int i = 0;
+	while (!(bits & 1)) {
+		bits >>= 1;
+		++i;
+	}
+	return i;
+#endif
+}
+
+// Runs breadth first searches from up to 64 * words source ids at once (MS-BFS). Every vertex
+// keeps a bitmask with one bit per search: seen holds the searches that have reached it, visit
+// those whose frontier it is on, and next those that reach it at the following level. A level
+// ORs each frontier vertex's visit mask into its neighbours' next masks, so one walk over an
+// adjacency list advances every search that shares it. Masks are stored word by word in flat
+// arrays, so the fixed-length OR loops compile to vector instructions.
+// Calls found(search, id, level) whenever search first reaches id, level 0 being its source.
+template <int words, typename vertex, typename F>
+void multi_source_bfs(const csr_graph<vertex>& c, const std::vector<int>& sources, F found) {
+	static_assert(words > 0, "at least one word of sources");
+	const int n = c.num_vertices();
+	std::vector<std::uint64_t> seen(n * words, 0);
+	std::vector<std::uint64_t> visit(n * words, 0);
+	std::vector<std::uint64_t> next(n * words, 0);
+
+	for (int i = 0; i < sources.size() && i < 64 * words; ++i) {
+		int s = sources[i];
+		if (s < 0) continue;
+		seen[s * words + i / 64] |= std::uint64_t(1) << (i % 64);
+		visit[s * words + i / 64] |= std::uint64_t(1) << (i % 64);
+		found(i, s, 0);
+	}
+
+	for (int level = 1; true; ++level) {
+		for (int u = 0; u < n; ++u) {
+			const std::uint64_t* from = &visit[u * words];
+			bool any = false;
+			for (int k = 0; k < words; ++k) any |= from[k] != 0;
+			if (!any) continue;
+			for (auto w = c.neighbours_begin(u); w != c.neighbours_end(u); ++w) {
+				std::uint64_t* to = &next[*w * words];
+				for (int k = 0; k < words; ++k) to[k] |= from[k];
+			}
+		}
+
+		bool advanced = false;
+		for (int u = 0; u < n; ++u) {
+			std::uint64_t* reaching = &next[u * words];
+			for (int k = 0; k < words; ++k) {
+				// Only the searches that had not been here yet
+				std::uint64_t bits = reaching[k] & ~seen[u * words + k];
+				reaching[k] = bits;
+				if (!bits) continue;
+				seen[u * words + k] |= bits;
+				advanced = true;
+				for (; bits; bits &= bits - 1) found(64 * k + lowest_bit(bits), u, level);
+			}
+		}
+		if (!advanced) return;
+		visit.swap(next);
+		std::fill(next.begin(), next.end(), 0);
+	}
+}
+
+// Returns the hop distance from every source to every dense id of c, or -1 where it is unreachable.
+// The sources are searched 64 * words at a time, so 256 sources with words = 4 take one set of
+// passes over the graph instead of 256 separate traversals.
+template <int words = 1, typename vertex>
+std::vector<std::vector<int>> multi_source_distances(const csr_graph<vertex>& c, const std::vector<vertex>& sources) {
+	std::vector<std::vector<int>> distances(sources.size(), std::vector<int>(c.num_vertices(), -1));
+	for (int first = 0; first < sources.size(); first += 64 * words) {
+		std::vector<int> batch;
+		for (int i = first; i < sources.size() && i < first + 64 * words; ++i) {
+			batch.push_back(c.has_vertex(sources[i]) ? c.index_of(sources[i]) : -1);
+		}
+		multi_source_bfs<words>(c, batch, [&](int search, int id, int level) { distances[first + search][id] = level; });
+	}
+	return distances;
+}
+
+// Returns how many vertices each source reaches and how far away they are, in the order of sources,
+// without ever storing a distance.
+template <int words = 1, typename vertex>
+std::vector<bfs_summary> multi_source_summaries(const csr_graph<vertex>& c, const std::vector<vertex>& sources) {
+	std::vector<bfs_summary> summaries(sources.size());
+	for (int first = 0; first < sources.size(); first += 64 * words) {
+		std::vector<int> batch;
+		for (int i = first; i < sources.size() && i < first + 64 * words; ++i) {
+			batch.push_back(c.has_vertex(sources[i]) ? c.index_of(sources[i]) : -1);
+		}
+		multi_source_bfs<words>(c, batch, [&](int search, int, int level) {
+			bfs_summary& summary = summaries[first + search];
+			++summary.reached;
+			summary.total_distance += level;
+			summary.eccentricity = std::max(summary.eccentricity, level);
+		});
+	}
+	return summaries;
+}
+
+// As above, over a snapshot of g's adjacency.
+template <int words = 1, typename vertex>
+std::vector<bfs_summary> multi_source_summaries(const weighted_graph<vertex>& g, const std::vector<vertex>& sources) {
+	return multi_source_summaries<words>(csr_graph<vertex>(g), sources);
+}
+
+#endif
@@ -0,0 +1,76 @@
+#ifndef PARALLEL_BFS
+#define PARALLEL_BFS
+
+#include <vector>
+#include <atomic>
+#include "csr_graph.hpp"
+#include "thread_pool.hpp"
+
+// The tree grown by a breadth first search of a csr_graph, indexed by dense id.
+// Vertices the search did not reach have level -1 and parent -1; the source is its own parent.
+struct bfs_tree {
+	std::vector<int> level;
+	std::vector<int> parent;
+};
+
+// Breadth first search of the frozen graph from start_vertex, one level at a time. Each frontier
+// is split over the pool, whose workers steal from each other when their share runs out, so a
+// few high degree vertices do not hold up a whole level. A vertex is claimed by whichever thread first swaps its
+// parent from -1, and every thread collects the vertices it claimed in its own buffer for the
+// next frontier, so nothing but the parent array is shared.
+// Any vertex the search reaches at level l has a parent at level l - 1, but which one it gets
+// depends on thread timing when there are several.
+template <typename vertex>
+bfs_tree parallel_breadth_first(const csr_graph<vertex>& c, const vertex& start_vertex, thread_pool& pool) {
+	const int n = c.num_vertices();
+	bfs_tree tree;
+	tree.level.assign(n, -1);
+	tree.parent.assign(n, -1);
+	if (!c.has_vertex(start_vertex)) return tree;
+	const int source = c.index_of(start_vertex);
+
+	std::vector<std::atomic<int>> parent(n);
+	pool.parallel_for(0, n, 4096, [&](int begin, int end, int) {
+		for (int u = begin; u < end; ++u) parent[u].store(-1, std::memory_order_relaxed);
+	});
+	parent[source].store(source, std::memory_order_relaxed);
+	tree.level[source] = 0;
+
+	std::vector<int> frontier(1, source);
+	std::vector<int> next;
+	std::vector<std::vector<int>> next_local(pool.size());
+	for (int depth = 1; !frontier.empty(); ++depth) {
+		pool.parallel_for(0, frontier.size(), 64, [&](int begin, int end, int worker) {
+			std::vector<int>& local = next_local[worker];
+			for (int i = begin; i < end; ++i) {
+				int u = frontier[i];
+				for (auto w = c.neighbours_begin(u); w != c.neighbours_end(u); ++w) {
+					// Reading first skips the far more expensive swap for vertices already taken
+					int expected = -1;
+					if (parent[*w].load(std::memory_order_relaxed) == -1
+						&& parent[*w].compare_exchange_strong(expected, u, std::memory_order_relaxed)) {
+						tree.level[*w] = depth;
+						local.push_back(*w);
+					}
+				}
+			}
+		});
+
+		// Gather the buffers into the next frontier, each worker copying its own into place
+		std::vector<int> offsets(pool.size() + 1, 0);
+		for (int w = 0; w < pool.size(); ++w) offsets[w + 1] = offsets[w] + next_local[w].size();
+		next.resize(offsets.back());
+		pool.run([&](int worker) {
+			std::copy(next_local[worker].begin(), next_local[worker].end(), next.begin() + offsets[worker]);
+			next_local[worker].clear();
+		});
+		frontier.swap(next);
+	}
+
+	pool.parallel_for(0, n, 4096, [&](int begin, int end, int) {
+		for (int u = begin; u < end; ++u) tree.parent[u] = parent[u].load(std::memory_order_relaxed);
+	});
+	return tree;
+}
+
+#endif
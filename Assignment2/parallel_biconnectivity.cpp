@@ -0,0 +1,245 @@
+#ifndef PARALLEL_BICONNECTIVITY
+#define PARALLEL_BICONNECTIVITY
+
+#include <vector>
+#include <atomic>
+#include <utility>
+#include <algorithm>
+#include "weighted_graph.hpp"
+#include "csr_graph.hpp"
+#include "thread_pool.hpp"
+#include "concurrent_disjoint_set.hpp"
+#include "biconnectivity.cpp"
+
+// Computes the same decomposition as biconnected_components using the Tarjan-Vishkin method,
+// with every pass spread over the thread pool:
+//   1. a spanning forest is grown by a level-synchronous breadth first search from the smallest
+//      vertex of every connected component,
+//   2. subtree sizes and preorder (Euler tour) numbers are computed level by level,
+//   3. low and high, the smallest and largest preorder number reachable from a subtree over one
+//      non-tree edge, are aggregated bottom up,
+//   4. tree edges are joined in an auxiliary graph whenever they must share a block, and the
+//      connected components of that graph are the biconnected components.
+// No step needs a depth first search, so none of them is inherently serial.
+// Articulation points come back in the graph's iteration order, exactly as biconnected_components
+// returns them; blocks and bridges hold the same sets but may be listed in a different order.
+template <typename vertex>
+biconnected_decomposition<vertex> parallel_biconnected_components(const weighted_graph<vertex>& g, thread_pool& pool) {
+	biconnected_decomposition<vertex> result;
+	csr_graph<vertex> c(g);
+	const int n = c.num_vertices();
+	const int grain = 1024;
+	if (n == 0) return result;
+
+	// Connected components first, so that every tree of the forest can be grown at the same time
+	concurrent_disjoint_set components(n);
+	pool.parallel_for(0, n, grain, [&](int begin, int end, int) {
+		for (int u = begin; u < end; ++u) {
+			for (auto w = c.neighbours_begin(u); w != c.neighbours_end(u); ++w) {
+				if (u < *w) components.unite(u, *w);
+			}
+		}
+	});
+
+	std::vector<std::atomic<int>> parent(n);
+	std::vector<std::vector<int>> levels(1);
+	for (int u = 0; u < n; ++u) {
+		// Each set's root is its smallest id once uniting has finished
+		bool root = components.find(u) == u;
+		parent[u].store(root ? u : -1, std::memory_order_relaxed);
+		if (root) levels[0].push_back(u);
+	}
+
+	// Spanning forest by breadth first search, claiming each vertex with a compare-and-swap on its parent
+	std::vector<std::vector<int>> next_local(pool.size());
+	while (!levels.back().empty()) {
+		const std::vector<int>& frontier = levels.back();
+		pool.parallel_for(0, frontier.size(), 64, [&](int begin, int end, int worker) {
+			for (int i = begin; i < end; ++i) {
+				int u = frontier[i];
+				for (auto w = c.neighbours_begin(u); w != c.neighbours_end(u); ++w) {
+					int expected = -1;
+					if (parent[*w].load(std::memory_order_relaxed) == -1
+						&& parent[*w].compare_exchange_strong(expected, u, std::memory_order_relaxed)) {
+						next_local[worker].push_back(*w);
+					}
+				}
+			}
+		});
+		std::vector<int> next;
+		for (auto& local : next_local) {
+			next.insert(next.end(), local.begin(), local.end());
+			local.clear();
+		}
+		levels.push_back(std::move(next));
+	}
+	levels.pop_back();
+
+	std::vector<int> tree_parent(n);
+	for (int u = 0; u < n; ++u) tree_parent[u] = parent[u].load(std::memory_order_relaxed);
+
+	// Lay the children of every vertex out contiguously
+	std::vector<int> child_offsets(n + 1, 0);
+	for (int u = 0; u < n; ++u) if (tree_parent[u] != u) ++child_offsets[tree_parent[u] + 1];
+	for (int u = 0; u < n; ++u) child_offsets[u + 1] += child_offsets[u];
+	std::vector<int> children(child_offsets.back());
+	std::vector<std::atomic<int>> fill(n);
+	for (int u = 0; u < n; ++u) fill[u].store(child_offsets[u], std::memory_order_relaxed);
+	pool.parallel_for(0, n, grain, [&](int begin, int end, int) {
+		for (int u = begin; u < end; ++u) {
+			if (tree_parent[u] != u) children[fill[tree_parent[u]].fetch_add(1, std::memory_order_relaxed)] = u;
+		}
+	});
+
+	// Subtree sizes, deepest level first
+	std::vector<int> subtree_size(n, 1);
+	for (int level = levels.size() - 1; level >= 0; --level) {
+		const std::vector<int>& current = levels[level];
+		pool.parallel_for(0, current.size(), grain, [&](int begin, int end, int) {
+			for (int i = begin; i < end; ++i) {
+				int u = current[i];
+				for (int j = child_offsets[u]; j < child_offsets[u + 1]; ++j) subtree_size[u] += subtree_size[children[j]];
+			}
+		});
+	}
+
+	// Preorder numbers, shallowest level first. A child's number follows its parent's and the subtrees of its earlier siblings.
+	std::vector<int> preorder(n, 0);
+	int next_number = 0;
+	for (int root : levels[0]) {
+		preorder[root] = next_number;
+		next_number += subtree_size[root];
+	}
+	for (int level = 0; level < levels.size(); ++level) {
+		const std::vector<int>& current = levels[level];
+		pool.parallel_for(0, current.size(), grain, [&](int begin, int end, int) {
+			for (int i = begin; i < end; ++i) {
+				int u = current[i];
+				int number = preorder[u] + 1;
+				for (int j = child_offsets[u]; j < child_offsets[u + 1]; ++j) {
+					preorder[children[j]] = number;
+					number += subtree_size[children[j]];
+				}
+			}
+		});
+	}
+
+	auto is_tree_edge = [&](int u, int w) { return tree_parent[u] == w || tree_parent[w] == u; };
+	auto is_descendant = [&](int u, int ancestor) {
+		return preorder[ancestor] <= preorder[u] && preorder[u] < preorder[ancestor] + subtree_size[ancestor];
+	};
+
+	// low and high over each vertex's own non-tree edges, then folded up the tree
+	std::vector<int> low(n);
+	std::vector<int> high(n);
+	pool.parallel_for(0, n, grain, [&](int begin, int end, int) {
+		for (int u = begin; u < end; ++u) {
+			low[u] = high[u] = preorder[u];
+			for (auto w = c.neighbours_begin(u); w != c.neighbours_end(u); ++w) {
+				if (*w == u || is_tree_edge(u, *w)) continue;
+				low[u] = std::min(low[u], preorder[*w]);
+				high[u] = std::max(high[u], preorder[*w]);
+			}
+		}
+	});
+	for (int level = levels.size() - 1; level >= 0; --level) {
+		const std::vector<int>& current = levels[level];
+		pool.parallel_for(0, current.size(), grain, [&](int begin, int end, int) {
+			for (int i = begin; i < end; ++i) {
+				int u = current[i];
+				for (int j = child_offsets[u]; j < child_offsets[u + 1]; ++j) {
+					low[u] = std::min(low[u], low[children[j]]);
+					high[u] = std::max(high[u], high[children[j]]);
+				}
+			}
+		});
+	}
+
+	// The auxiliary graph has a node per tree edge, named after the child end of the edge
+	concurrent_disjoint_set auxiliary(n);
+	pool.parallel_for(0, n, grain, [&](int begin, int end, int) {
+		for (int u = begin; u < end; ++u) {
+			// A non-tree edge between unrelated vertices puts both their parent edges on one cycle
+			for (auto w = c.neighbours_begin(u); w != c.neighbours_end(u); ++w) {
+				if (*w == u || is_tree_edge(u, *w) || preorder[u] > preorder[*w]) continue;
+				if (!is_descendant(*w, u)) auxiliary.unite(u, *w);
+			}
+			// A child's subtree that escapes its parent's subtree puts both tree edges on one cycle
+			int p = tree_parent[u];
+			if (p != u && tree_parent[p] != p) {
+				if (low[u] < preorder[p] || high[u] >= preorder[p] + subtree_size[p]) auxiliary.unite(u, p);
+			}
+		}
+	});
+
+	std::vector<char> is_cut(n, false); // not vector<bool>, whose packed bits cannot be written from several threads
+	std::vector<int> label(n, -1);
+	pool.parallel_for(0, n, grain, [&](int begin, int end, int) {
+		for (int u = begin; u < end; ++u) if (tree_parent[u] != u) label[u] = auxiliary.find(u);
+	});
+	std::vector<int> bridge_children;
+	std::vector<std::vector<int>> bridge_local(pool.size());
+	pool.parallel_for(0, n, grain, [&](int begin, int end, int worker) {
+		for (int u = begin; u < end; ++u) {
+			// u is a cut vertex when the tree edges touching it fall in more than one block. Unlike a
+			// depth first tree, a root with several children need not be one, as cross edges can join them.
+			int own = tree_parent[u] == u ? -1 : label[u];
+			for (int j = child_offsets[u]; j < child_offsets[u + 1] && !is_cut[u]; ++j) {
+				if (own == -1) own = label[children[j]];
+				else if (label[children[j]] != own) is_cut[u] = true;
+			}
+			if (tree_parent[u] != u) {
+				// Nothing leaves u's subtree except its parent edge
+				if (low[u] >= preorder[u] && high[u] < preorder[u] + subtree_size[u]) bridge_local[worker].push_back(u);
+			}
+		}
+	});
+	for (auto& local : bridge_local) bridge_children.insert(bridge_children.end(), local.begin(), local.end());
+	std::sort(bridge_children.begin(), bridge_children.end());
+	for (int u : bridge_children) result.bridges.push_back({c.vertex_at(tree_parent[u]), c.vertex_at(u)});
+
+	// Group the endpoints of the tree edges by block
+	std::vector<int> block_of(n, -1);
+	int blocks = 0;
+	for (int u = 0; u < n; ++u) {
+		if (tree_parent[u] == u && child_offsets[u + 1] == child_offsets[u]) block_of[u] = blocks++; // isolated vertex
+		else if (label[u] == u) block_of[u] = blocks++;
+	}
+	result.components.resize(blocks);
+	std::vector<int> in_block(n, -1);
+	for (int u = 0; u < n; ++u) {
+		if (tree_parent[u] == u) {
+			if (block_of[u] != -1) result.components[block_of[u]].push_back(c.vertex_at(u));
+			continue;
+		}
+		int block = block_of[label[u]];
+		for (int x : {tree_parent[u], u}) {
+			// Blocks are filled interleaved, so this only catches repeats in a row; the rest are removed below
+			if (in_block[x] != block) {
+				in_block[x] = block;
+				result.components[block].push_back(c.vertex_at(x));
+			}
+		}
+	}
+	pool.parallel_for(0, blocks, 64, [&](int begin, int end, int) {
+		for (int b = begin; b < end; ++b) {
+			auto& component = result.components[b];
+			std::sort(component.begin(), component.end());
+			component.erase(std::unique(component.begin(), component.end()), component.end());
+		}
+	});
+
+	for (auto g_it = g.cbegin(); g_it != g.cend(); ++g_it) {
+		if (is_cut[c.index_of(*g_it)]) result.articulation_points.push_back(*g_it);
+	}
+	result.block_cut_tree = build_block_cut_tree(c, result.components, std::vector<bool>(is_cut.begin(), is_cut.end()));
+	return result;
+}
+
+// Returns the articulation points of g, in the same order as articulation_points.
+template <typename vertex>
+std::vector<vertex> parallel_articulation_points(const weighted_graph<vertex>& g, thread_pool& pool) {
+	return parallel_biconnected_components(g, pool).articulation_points;
+}
+
+#endif
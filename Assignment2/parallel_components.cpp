@@ -0,0 +1,143 @@
+#ifndef PARALLEL_COMPONENTS
+#define PARALLEL_COMPONENTS
+
+#include <vector>
+#include <random>
+#include <limits>
+#include <algorithm>
+#include <unordered_map>
+#include "weighted_graph.hpp"
+#include "csr_graph.hpp"
+#include "thread_pool.hpp"
+#include "concurrent_disjoint_set.hpp"
+#include "graph_algorithms.cpp"
+
+// Walks the neighbours of a csr_graph by dense id.
+template <typename vertex>
+struct csr_adjacency {
+	const csr_graph<vertex>& c;
+
+	int size() const { return c.num_vertices(); }
+
+	// Calls f on the neighbours of u at positions first, first+1, ... up to but excluding last
+	template <typename F> void for_each_neighbour(int u, int first, int last, F f) const {
+		auto w = c.neighbours_begin(u);
+		for (int i = first; i < std::min(last, c.degree(u)); ++i) f(w[i]);
+	}
+};
+
+// Walks the neighbour maps of a weighted_graph directly, numbering the vertices in iteration order.
+template <typename vertex>
+struct hash_adjacency {
+	const weighted_graph<vertex>& g;
+	std::vector<vertex> vertices;
+	std::unordered_map<vertex, int> ids;
+
+	explicit hash_adjacency(const weighted_graph<vertex>& graph) : g(graph), vertices(graph.cbegin(), graph.cend()) {
+		ids.reserve(vertices.size());
+		for (int i = 0; i < vertices.size(); ++i) ids[vertices[i]] = i;
+	}
+
+	int size() const { return vertices.size(); }
+
+	template <typename F> void for_each_neighbour(int u, int first, int last, F f) const {
+		int position = 0;
+		for (auto n_it = g.cneighbours_begin(vertices[u]); n_it != g.cneighbours_end(vertices[u]) && position < last; ++n_it, ++position) {
+			if (position >= first) f(ids.at(n_it->first));
+		}
+	}
+};
+
+// Unites the connected components of the adjacency in sets using Afforest:
+//   1. every vertex is linked to its first few neighbours, which on most graphs already gathers
+//      the bulk of the vertices into one giant component,
+//   2. a random sample of vertices guesses which set that giant component is,
+//   3. only vertices outside the giant component go on to link their remaining neighbours.
+// Links and compressions are lock-free compare-and-swaps on the shared parent array.
+template <typename adjacency>
+void afforest(const adjacency& adj, concurrent_disjoint_set& sets, thread_pool& pool, int neighbour_rounds = 2, unsigned seed = 0) {
+	const int n = adj.size();
+	const int grain = 1024;
+	if (n == 0) return;
+
+	for (int round = 0; round < neighbour_rounds; ++round) {
+		pool.parallel_for(0, n, grain, [&](int begin, int end, int) {
+			for (int u = begin; u < end; ++u) adj.for_each_neighbour(u, round, round + 1, [&](int w) { sets.unite(u, w); });
+		});
+		pool.parallel_for(0, n, grain, [&](int begin, int end, int) {
+			for (int u = begin; u < end; ++u) sets.compress(u);
+		});
+	}
+
+	// After compression most vertices point straight at their root, so a sample's most common parent is the giant component
+	const int samples = 1024;
+	std::mt19937 rng(seed);
+	std::uniform_int_distribution<int> any(0, n - 1);
+	std::unordered_map<int, int> counts;
+	int giant = sets.parent_of(any(rng));
+	for (int i = 0; i < samples; ++i) {
+		int root = sets.parent_of(any(rng));
+		if (++counts[root] > counts[giant]) giant = root;
+	}
+
+	pool.parallel_for(0, n, grain, [&](int begin, int end, int) {
+		for (int u = begin; u < end; ++u) {
+			if (sets.find(u) == giant) continue;
+			// The first neighbours were linked in the sampling rounds already
+			adj.for_each_neighbour(u, neighbour_rounds, std::numeric_limits<int>::max(), [&](int w) { sets.unite(u, w); });
+		}
+	});
+	pool.parallel_for(0, n, grain, [&](int begin, int end, int) {
+		for (int u = begin; u < end; ++u) sets.compress(u);
+	});
+}
+
+// Returns the component of every id of the frozen graph c, numbered from 0 in ascending order of each component's smallest id.
+template <typename vertex>
+std::vector<int> parallel_component_ids(const csr_graph<vertex>& c, thread_pool& pool) {
+	concurrent_disjoint_set sets(c.num_vertices());
+	afforest(csr_adjacency<vertex>{c}, sets, pool);
+	// Every root is its component's smallest id, so numbering roots in id order numbers components by their smallest id
+	std::vector<int> labels(c.num_vertices());
+	int components = 0;
+	for (int u = 0; u < c.num_vertices(); ++u) {
+		int root = sets.parent_of(u);
+		labels[u] = root == u ? components++ : labels[root];
+	}
+	return labels;
+}
+
+// Returns the same labelling as component_labels, computed in parallel straight over the graph's neighbour maps.
+template <typename vertex>
+component_labelling<vertex> parallel_component_labels(const weighted_graph<vertex>& g, thread_pool& pool) {
+	hash_adjacency<vertex> adj(g);
+	concurrent_disjoint_set sets(adj.size());
+	afforest(adj, sets, pool);
+
+	// Ids follow the graph's iteration order and each root is its component's smallest id,
+	// so numbering the roots in id order reproduces component_labels' first-appearance numbering
+	component_labelling<vertex> labelling;
+	std::vector<int> labels(adj.size());
+	labelling.component.reserve(adj.size());
+	for (int u = 0; u < adj.size(); ++u) {
+		int root = sets.parent_of(u);
+		if (root == u) {
+			labels[u] = labelling.sizes.size();
+			labelling.sizes.push_back(0);
+		}
+		else {
+			labels[u] = labels[root];
+		}
+		++labelling.sizes[labels[u]];
+		labelling.component[adj.vertices[u]] = labels[u];
+	}
+	return labelling;
+}
+
+// Returns the connected components of g as separate graphs, in the same order as connected_components.
+template <typename vertex>
+std::vector<weighted_graph<vertex>> parallel_connected_components(const weighted_graph<vertex>& g, thread_pool& pool) {
+	return component_subgraphs(g, parallel_component_labels(g, pool));
+}
+
+#endif
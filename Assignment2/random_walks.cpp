@@ -0,0 +1,202 @@
+#ifndef RANDOM_WALKS
+#define RANDOM_WALKS
+
+#include <vector>
+#include <mutex>
+#include <stdexcept>
+#include <algorithm>
+#include "weighted_graph.hpp"
+#include "csr_graph.hpp"
+#include "thread_pool.hpp"
+
+// Settings for random walks. With p and q both 1 every step picks a neighbour in proportion to the
+// weight of the edge to it. Otherwise the walks are node2vec's second order walks: the step after
+// coming from t goes back to t with its weight divided by p, to a neighbour of t at its weight, and
+// further away with its weight divided by q.
+struct walk_options {
+	int length = 80; // vertices in each walk, counting the start; fewer if it reaches a vertex with no edges
+	int walks_per_vertex = 10;
+	double p = 1; // return parameter
+	double q = 1; // in-out parameter
+	unsigned long long seed = 0;
+	int batch_walks = 4096; // how many walks a worker collects before handing them over
+};
+
+// A small, fast generator (splitmix64), cheap enough to seed afresh for every walk so that each
+// walk depends only on the seed and its index, whichever worker happens to take it.
+struct walk_random {
+	unsigned long long state;
+
+	unsigned long long next() {
+		unsigned long long z = (state += 0x9e3779b97f4a7c15ULL);
+		z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+		z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+		return z ^ (z >> 31);
+	}
+	// Uniform in [0, bound)
+	int below(int bound) { return ((next() >> 32) * bound) >> 32; }
+	// Uniform in [0, 1)
+	double unit() { return (next() >> 11) * (1.0 / (1ULL << 53)); }
+};
+
+// One alias table per vertex of a csr_graph, laid out along its arcs, so a neighbour can be drawn
+// in proportion to edge weight in O(1): pick an arc of the row uniformly, then keep it with its
+// probability or take its alias instead (Vose). A row whose weights are all 0 is drawn uniformly.
+// Throws std::invalid_argument if any weight is negative.
+struct alias_tables {
+	std::vector<float> probability; // by arc
+	std::vector<int> alias; // by arc, the position within the row to take instead
+
+	template <typename vertex> alias_tables(const csr_graph<vertex>&, thread_pool&);
+
+	// Returns the position within u's row of a neighbour drawn at random.
+	template <typename vertex> int draw(const csr_graph<vertex>&, int u, walk_random&) const;
+};
+
+template <typename vertex> alias_tables::alias_tables(const csr_graph<vertex>& c, thread_pool& pool) {
+	for (int arc = 0; arc < c.num_arcs(); ++arc) {
+		if (c.weights_begin(0)[arc] < 0) throw std::invalid_argument("negative edge weight");
+	}
+	probability.resize(c.num_arcs());
+	alias.resize(c.num_arcs());
+
+	struct scratch {
+		std::vector<double> scaled;
+		std::vector<int> small, large;
+	};
+	std::vector<scratch> scratches(pool.size());
+	pool.parallel_for(0, c.num_vertices(), 256, [&](int begin, int end, int worker) {
+		scratch& s = scratches[worker];
+		for (int u = begin; u < end; ++u) {
+			const int d = c.degree(u);
+			// u's arcs are numbered from wherever its neighbours start in the csr_graph
+			int first = c.neighbours_begin(u) - c.neighbours_begin(0);
+			float* prob = probability.data() + first;
+			int* other = alias.data() + first;
+			double total = 0;
+			for (int i = 0; i < d; ++i) total += c.weights_begin(u)[i];
+			s.scaled.resize(d);
+			s.small.clear();
+			s.large.clear();
+			// Scaled so the weights average 1, then the light arcs are topped up from the heavy ones
+			for (int i = 0; i < d; ++i) {
+				s.scaled[i] = total > 0 ? c.weights_begin(u)[i] * d / total : 1;
+				(s.scaled[i] < 1 ? s.small : s.large).push_back(i);
+			}
+			while (!s.small.empty() && !s.large.empty()) {
+				int light = s.small.back(), heavy = s.large.back();
+				s.small.pop_back();
+				prob[light] = s.scaled[light];
+				other[light] = heavy;
+				s.scaled[heavy] -= 1 - s.scaled[light];
+				if (s.scaled[heavy] < 1) {
+					s.large.pop_back();
+					s.small.push_back(heavy);
+				}
+			}
+			// Whatever is left is 1 up to rounding
+			for (int i : s.small) prob[i] = 1, other[i] = i;
+			for (int i : s.large) prob[i] = 1, other[i] = i;
+		}
+	});
+}
+
+template <typename vertex> int alias_tables::draw(const csr_graph<vertex>& c, int u, walk_random& rng) const {
+	int i = rng.below(c.degree(u));
+	int arc = c.neighbours_begin(u) - c.neighbours_begin(0) + i;
+	return rng.unit() < probability[arc] ? i : alias[arc];
+}
+
+// A batch of finished walks, handed over together: walk k visited the ids from
+// steps[offsets[k]] up to steps[offsets[k + 1]], and is walk index[k]. Walk r * n + u is the r-th
+// walk from the id u.
+struct walk_batch {
+	std::vector<long long> index;
+	std::vector<long long> offsets{0};
+	std::vector<int> steps;
+
+	int size() const { return index.size(); }
+	void clear() {
+		index.clear();
+		offsets.assign(1, 0);
+		steps.clear();
+	}
+};
+
+// Walks options.walks_per_vertex times from every id of c, in parallel, and passes the walks to
+// consume in batches as they fill up, one batch at a time. Returns how many steps were taken in all.
+// Each walk draws from a walk_random seeded by options.seed and its index alone, so the walks are
+// the same however many workers there are; only the order the batches arrive in varies. A second
+// order step draws a neighbour by weight from the alias table and accepts it with its node2vec
+// bias over the largest bias, trying again on rejection, so no table per pair of vertices is needed.
+// Throws std::invalid_argument unless p and q are positive, as otherwise no step might ever be accepted.
+template <typename vertex, typename F>
+long long random_walks_ids(const csr_graph<vertex>& c, const alias_tables& tables, const walk_options& options, thread_pool& pool, F consume) {
+	if (!(options.p > 0 && options.q > 0)) throw std::invalid_argument("p and q must be positive");
+	const int n = c.num_vertices();
+	const bool second_order = options.p != 1 || options.q != 1;
+	const double back = 1 / options.p, away = 1 / options.q;
+	const double highest = std::max(1.0, std::max(back, away));
+	std::vector<walk_batch> batches(pool.size());
+	std::vector<long long> taken(pool.size(), 0);
+	std::mutex handing_over;
+	auto hand_over = [&](walk_batch& batch) {
+		std::lock_guard<std::mutex> lock(handing_over);
+		consume(static_cast<const walk_batch&>(batch));
+		batch.clear();
+	};
+
+	for (int round = 0; round < options.walks_per_vertex; ++round) {
+		pool.parallel_for(0, n, 64, [&](int begin, int end, int worker) {
+			walk_batch& batch = batches[worker];
+			for (int start = begin; start < end; ++start) {
+				long long walk = static_cast<long long>(round) * n + start;
+				walk_random rng{options.seed ^ (0x9e3779b97f4a7c15ULL * (walk + 1))};
+				int previous = -1, current = start;
+				batch.steps.push_back(current);
+				for (int step = 1; step < options.length && c.degree(current) > 0; ++step) {
+					int next;
+					while (true) {
+						next = c.neighbours_begin(current)[tables.draw(c, current, rng)];
+						if (!second_order || previous == -1) break;
+						double bias = next == previous ? back
+							: std::binary_search(c.neighbours_begin(previous), c.neighbours_end(previous), next) ? 1 : away;
+						if (rng.unit() * highest < bias) break;
+					}
+					previous = current;
+					current = next;
+					batch.steps.push_back(current);
+				}
+				taken[worker] += batch.steps.size() - batch.offsets.back() - 1;
+				batch.index.push_back(walk);
+				batch.offsets.push_back(batch.steps.size());
+				if (batch.size() >= options.batch_walks) hand_over(batch);
+			}
+		});
+	}
+	long long total = 0;
+	for (int w = 0; w < pool.size(); ++w) {
+		if (batches[w].size() > 0) hand_over(batches[w]);
+		total += taken[w];
+	}
+	return total;
+}
+
+// Returns options.walks_per_vertex random walks from every vertex of g, walk r * n + u being the
+// r-th from the u-th vertex in ascending order. Meant for checking and small graphs; large runs
+// should stream the batches from random_walks_ids instead of keeping every walk.
+template <typename vertex>
+std::vector<std::vector<vertex>> random_walks(const weighted_graph<vertex>& g, thread_pool& pool, const walk_options& options = {}) {
+	csr_graph<vertex> c(g);
+	alias_tables tables(c, pool);
+	std::vector<std::vector<vertex>> walks(static_cast<long long>(c.num_vertices()) * options.walks_per_vertex);
+	random_walks_ids(c, tables, options, pool, [&](const walk_batch& batch) {
+		for (int k = 0; k < batch.size(); ++k) {
+			auto& walk = walks[batch.index[k]];
+			for (long long s = batch.offsets[k]; s < batch.offsets[k + 1]; ++s) walk.push_back(c.vertex_at(batch.steps[s]));
+		}
+	});
+	return walks;
+}
+
+#endif
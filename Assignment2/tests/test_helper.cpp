@@ -73,28 +73,6 @@ std::map<vertex, int> compute_tree_distances(const weighted_graph<vertex>& t, co
 
 }
 
-template <typename vertex_t>
-struct bc_vertex{
-	vertex_t v;
-	bool isCut;
-	unsigned _id;
-	
-	bc_vertex(vertex_t vertex, bool is_cut, unsigned id) : v(vertex), isCut(is_cut), _id(id){}
-	
-	inline bool operator==(const bc_vertex<vertex_t>& other) const {
-	    return other.v == v && _id == other._id;
-    }
-};
-
-namespace std {
-    template <typename vertex>
-    struct hash<bc_vertex<vertex>> {
-        inline size_t operator()(const bc_vertex<vertex>& x) const {
-            return x.v.size() + 1;
-        }
-    };
-}
-
 template<typename vertex>
 weighted_graph<bc_vertex<vertex>> random_block_cut_tree(const std::vector<vertex>& components){
 
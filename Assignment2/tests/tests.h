@@ -12,6 +12,24 @@
 #include "weighted_graph.hpp"
 #include "test_helper.cpp"
 #include "graph_algorithms.cpp"
+#include "contraction_hierarchy.hpp"
+#include "parallel_biconnectivity.cpp"
+#include "parallel_components.cpp"
+#include "parallel_bfs.cpp"
+#include "multi_source_bfs.cpp"
+#include "minimum_spanning_forest.cpp"
+#include "core_decomposition.cpp"
+#include "triangle_counting.cpp"
+#include "betweenness.cpp"
+#include "diameter.cpp"
+#include "label_propagation.cpp"
+#include "graph_coloring.cpp"
+#include "random_walks.cpp"
+#include "k_shortest_paths.cpp"
+#include "distance_matrix.cpp"
+#include "dynamic_connectivity.hpp"
+#include "dynamic_spanning_forest.hpp"
+#include "dynamic_shortest_paths.hpp"
 
 class Management : public CxxTest::GlobalFixture{
 
@@ -266,6 +284,1068 @@ public:
 		
 	}
 	
+	void testFrozenTraversalsMatchSortedTraversals(){
+		
+		weighted_graph<int> g;
+		
+		auto r = (std::rand()%40) + 5;
+		
+		for (auto i = 0; i < r; ++i){
+			g.add_vertex(i);
+		}
+		
+		for (auto i = 0; i < 2*r; ++i){
+			auto u = std::rand()%r;
+			auto v = std::rand()%r;
+			if (u != v && !g.are_adjacent(u, v)) g.add_edge(u, v, std::rand()%10 + 1);
+		}
+		
+		csr_graph<int> frozen(g);
+		
+		for (auto v : g){
+			TS_ASSERT_EQUALS(depth_first(frozen, v), depth_first(g, v));
+			TS_ASSERT_EQUALS(breadth_first(frozen, v), breadth_first(g, v));
+			
+			// The unordered mode reaches the same vertices, in some order
+			auto expected = depth_first(g, v);
+			std::sort(expected.begin(), expected.end());
+			auto df_reached = depth_first(g, v, traversal_order::unordered);
+			auto bf_reached = breadth_first(g, v, traversal_order::unordered);
+			std::sort(df_reached.begin(), df_reached.end());
+			std::sort(bf_reached.begin(), bf_reached.end());
+			TS_ASSERT_EQUALS(df_reached, expected);
+			TS_ASSERT_EQUALS(bf_reached, expected);
+		}
+		
+	}
+	
+	void testTraversalWorkspaceReuse(){
+		
+		weighted_graph<int> g;
+		
+		auto r = (std::rand()%60) + 5;
+		
+		for (auto i = 0; i < r; ++i){
+			g.add_vertex(i);
+		}
+		
+		for (auto i = 0; i < r; ++i){
+			auto u = std::rand()%r;
+			auto v = std::rand()%r;
+			if (u != v && !g.are_adjacent(u, v)) g.add_edge(u, v, std::rand()%10 + 1);
+		}
+		
+		csr_graph<int> c(g);
+		traversal_workspace ws;
+		std::vector<int> order;
+		
+		// One workspace carried through every query must give the same answers as fresh ones
+		for (auto v : g){
+			depth_first(c, v, ws, order);
+			TS_ASSERT_EQUALS(order, depth_first(g, v));
+			breadth_first(c, v, ws, order);
+			TS_ASSERT_EQUALS(order, breadth_first(g, v));
+			
+			dijkstras(c, v, ws);
+			auto expected = dijkstras(g, v);
+			for (auto u : g){
+				TS_ASSERT_EQUALS(ws.distance(c.index_of(u)), expected.at(u));
+			}
+		}
+		
+		std::vector<int> component;
+		auto components = component_ids(c, ws, component);
+		auto labelling = component_labels(g);
+		TS_ASSERT_EQUALS(components, labelling.sizes.size());
+		for (auto u : g){
+			for (auto v : g){
+				TS_ASSERT_EQUALS(component[c.index_of(u)] == component[c.index_of(v)], labelling.component.at(u) == labelling.component.at(v));
+			}
+		}
+		
+	}
+	
+	void testLazyTraversalsMatchTraversals(){
+		
+		weighted_graph<int> g;
+		
+		auto r = (std::rand()%40) + 5;
+		
+		for (auto i = 0; i < r; ++i){
+			g.add_vertex(i);
+		}
+		
+		for (auto i = 0; i < r; ++i){
+			auto u = std::rand()%r;
+			auto v = std::rand()%r;
+			if (u != v && !g.are_adjacent(u, v)) g.add_edge(u, v, std::rand()%10 + 1);
+		}
+		
+		for (auto v : g){
+			for (auto order : {traversal_order::sorted, traversal_order::unordered}){
+				auto df_range = lazy_depth_first(g, v, order);
+				auto bf_range = lazy_breadth_first(g, v, order);
+				TS_ASSERT_EQUALS(std::vector<int>(df_range.begin(), df_range.end()), depth_first(g, v, order));
+				TS_ASSERT_EQUALS(std::vector<int>(bf_range.begin(), bf_range.end()), breadth_first(g, v, order));
+			}
+			
+			auto reached = depth_first(g, v);
+			for (auto u : g){
+				auto expected = std::find(reached.begin(), reached.end(), u) != reached.end();
+				TS_ASSERT_EQUALS(is_reachable(g, v, u), expected);
+			}
+		}
+		
+		TS_ASSERT(!is_reachable(g, 0, r));
+		
+	}
+	
+	void testMinimumSpanningForest(){
+		
+		weighted_graph<int> g;
+		
+		auto r = (std::rand()%300) + 1;
+		
+		for (auto i = 0; i < r; ++i){
+			g.add_vertex(i);
+		}
+		
+		for (auto i = 0; i < 3*r; ++i){
+			auto u = std::rand()%r;
+			auto v = std::rand()%r;
+			if (u != v && !g.are_adjacent(u, v)) g.add_edge(u, v, std::rand()%10 + 1);
+		}
+		
+		csr_graph<int> c(g);
+		auto prim_weight = 0;
+		for (auto e : prim_spanning_forest_ids(c)) prim_weight += e.weight;
+		
+		auto forest = minimum_spanning_forest(g);
+		auto labelling = component_labels(g);
+		
+		// Edges of g joining as many components as g has, with one edge fewer than vertices in each: a spanning
+		// tree of every component, and no heavier than Prim's
+		TS_ASSERT_EQUALS(forest.num_vertices(), g.num_vertices());
+		TS_ASSERT_EQUALS(forest.num_edges(), g.num_vertices() - labelling.sizes.size());
+		TS_ASSERT_EQUALS(component_labels(forest).sizes.size(), labelling.sizes.size());
+		TS_ASSERT_EQUALS(forest.total_weight(), prim_weight);
+		for (auto u : forest){
+			for (auto n_it = forest.neighbours_begin(u); n_it != forest.neighbours_end(u); ++n_it){
+				TS_ASSERT_EQUALS(g.get_edge_weight(u, n_it->first), n_it->second);
+			}
+		}
+		
+		thread_pool pool(4);
+		auto edges = minimum_spanning_forest_edges(g, pool);
+		TS_ASSERT_EQUALS(edges.size(), forest.num_edges());
+		for (auto i = 1; i < edges.size(); ++i){
+			TS_ASSERT(edges[i-1].weight <= edges[i].weight);
+		}
+		
+	}
+	
+	void testCoreDecomposition(){
+		
+		weighted_graph<int> g;
+		
+		auto r = (std::rand()%200) + 1;
+		
+		for (auto i = 0; i < r; ++i){
+			g.add_vertex(i);
+		}
+		
+		for (auto i = 0; i < 4*r; ++i){
+			auto u = std::rand()%r;
+			auto v = std::rand()%r;
+			if (u != v && !g.are_adjacent(u, v)) g.add_edge(u, v, 1);
+		}
+		
+		auto decomposition = core_numbers(g);
+		thread_pool pool(4);
+		TS_ASSERT_EQUALS(parallel_core_numbers(g, pool), decomposition.core);
+		TS_ASSERT_EQUALS(decomposition.order.size(), g.num_vertices());
+		
+		for (auto k = 0; k <= decomposition.degeneracy + 1; ++k){
+			auto core = k_core(g, decomposition.core, k);
+			// Every vertex of the k-core keeps at least k neighbours inside it...
+			for (auto u : core){
+				TS_ASSERT(core.degree(u) >= k);
+			}
+			// ...and it is the largest such subgraph, so peeling what is left of g below degree k removes nothing of it
+			auto rest = g;
+			auto peeled = true;
+			while (peeled){
+				peeled = false;
+				for (auto u : std::vector<int>(rest.begin(), rest.end())){
+					if (rest.degree(u) < k){
+						rest.remove_vertex(u);
+						peeled = true;
+					}
+				}
+			}
+			TS_ASSERT_EQUALS(rest.num_vertices(), core.num_vertices());
+			TS_ASSERT_EQUALS(rest.num_edges(), core.num_edges());
+		}
+		TS_ASSERT(k_core(g, decomposition.core, decomposition.degeneracy).num_vertices() > 0);
+		
+	}
+	
+	void testTriangleCounting(){
+		
+		weighted_graph<int> g;
+		
+		auto r = (std::rand()%60) + 3;
+		
+		for (auto i = 0; i < r; ++i){
+			g.add_vertex(i);
+		}
+		
+		for (auto i = 0; i < 5*r; ++i){
+			auto u = std::rand()%r;
+			auto v = std::rand()%r;
+			if (u != v && !g.are_adjacent(u, v)) g.add_edge(u, v, 1);
+		}
+		
+		thread_pool pool(4);
+		auto statistics = count_triangles(g, pool);
+		TS_ASSERT_EQUALS(total_triangles(csr_graph<int>(g), pool), statistics.total);
+		
+		// Brute force: every triple of vertices, checked with are_adjacent
+		auto total = 0;
+		std::unordered_map<int, int> through;
+		for (auto a = 0; a < r; ++a){
+			for (auto b = a + 1; b < r; ++b){
+				if (!g.are_adjacent(a, b)) continue;
+				for (auto c = b + 1; c < r; ++c){
+					if (g.are_adjacent(a, c) && g.are_adjacent(b, c)){
+						++total;
+						++through[a];
+						++through[b];
+						++through[c];
+					}
+				}
+			}
+		}
+		
+		TS_ASSERT_EQUALS(statistics.total, total);
+		for (auto u : g){
+			TS_ASSERT_EQUALS(statistics.triangles.at(u), through[u]);
+			auto d = g.degree(u);
+			auto expected = d < 2 ? 0.0 : 2.0 * through[u] / (d * (d - 1));
+			TS_ASSERT_DELTA(statistics.clustering.at(u), expected, 1e-9);
+		}
+		
+	}
+	
+	void testBetweennessCentrality(){
+		
+		weighted_graph<int> g;
+		
+		auto r = (std::rand()%25) + 2;
+		
+		for (auto i = 0; i < r; ++i){
+			g.add_vertex(i);
+		}
+		
+		for (auto i = 0; i < 3*r; ++i){
+			auto u = std::rand()%r;
+			auto v = std::rand()%r;
+			if (u != v && !g.are_adjacent(u, v)) g.add_edge(u, v, std::rand()%3 + 1);
+		}
+		
+		// Count the shortest paths between every pair from dijkstras' distances, nearest vertices first
+		auto infinity = std::numeric_limits<int>::max();
+		std::vector<std::map<int, int>> distance;
+		std::vector<std::vector<double>> paths(r, std::vector<double>(r, 0));
+		for (auto s = 0; s < r; ++s){
+			distance.push_back(dijkstras(g, s));
+			std::vector<int> nearest;
+			for (auto v = 0; v < r; ++v) if (distance[s][v] != infinity) nearest.push_back(v);
+			std::sort(nearest.begin(), nearest.end(), [&](int a, int b){ return distance[s][a] < distance[s][b]; });
+			paths[s][s] = 1;
+			for (auto v : nearest){
+				for (auto n_it = g.neighbours_begin(v); n_it != g.neighbours_end(v); ++n_it){
+					if (distance[s][n_it->first] != infinity && distance[s][n_it->first] + n_it->second == distance[s][v]) paths[s][v] += paths[s][n_it->first];
+				}
+			}
+		}
+		
+		std::vector<double> expected(r, 0);
+		for (auto s = 0; s < r; ++s){
+			for (auto t = s + 1; t < r; ++t){
+				if (distance[s][t] == infinity) continue;
+				for (auto v = 0; v < r; ++v){
+					if (v == s || v == t || distance[s][v] == infinity || distance[v][t] == infinity) continue;
+					if (distance[s][v] + distance[v][t] == distance[s][t]) expected[v] += paths[s][v] * paths[v][t] / paths[s][t];
+				}
+			}
+		}
+		
+		thread_pool pool(4);
+		auto centrality = betweenness_centrality(g, pool);
+		for (auto v = 0; v < r; ++v){
+			TS_ASSERT_DELTA(centrality.at(v), expected[v], 1e-6);
+		}
+		
+		// A sample no smaller than the graph falls back to the exact values
+		auto approximate = approximate_betweenness_centrality(g, pool, 0.001, 0.1);
+		for (auto v = 0; v < r; ++v){
+			TS_ASSERT_DELTA(approximate.at(v), expected[v], 1e-6);
+		}
+		
+	}
+	
+	void testDiameterAndEccentricity(){
+		
+		weighted_graph<int> g;
+		weighted_graph<int> unit;
+		
+		auto r = (std::rand()%40) + 1;
+		
+		for (auto i = 0; i < r; ++i){
+			g.add_vertex(i);
+			unit.add_vertex(i);
+		}
+		
+		for (auto i = 0; i < r; ++i){
+			auto u = std::rand()%r;
+			auto v = std::rand()%r;
+			if (u != v && !g.are_adjacent(u, v)){
+				g.add_edge(u, v, std::rand()%10 + 1);
+				unit.add_edge(u, v, 1);
+			}
+		}
+		
+		auto components = connected_components(g);
+		auto diameters = component_diameters(g);
+		auto report = eccentricities(g);
+		TS_ASSERT_EQUALS(diameters.size(), components.size());
+		TS_ASSERT_EQUALS(report.diameter.size(), components.size());
+		
+		// Every eccentricity from a dijkstras of its own
+		auto infinity = std::numeric_limits<int>::max();
+		for (auto i = 0; i < components.size(); ++i){
+			auto diameter = 0;
+			auto radius = infinity;
+			for (auto u : components[i]){
+				auto eccentricity = 0;
+				for (auto d : dijkstras(components[i], u)) eccentricity = std::max(eccentricity, d.second);
+				TS_ASSERT_EQUALS(report.eccentricity.at(u), eccentricity);
+				diameter = std::max(diameter, eccentricity);
+				radius = std::min(radius, eccentricity);
+			}
+			TS_ASSERT_EQUALS(diameters[i].diameter, diameter);
+			TS_ASSERT_EQUALS(dijkstras(g, diameters[i].from).at(diameters[i].to), diameter);
+			TS_ASSERT(components[i].has_vertex(diameters[i].from));
+			TS_ASSERT_LESS_THAN_EQUALS(diameters[i].searches, components[i].num_vertices() + 5);
+			TS_ASSERT_EQUALS(report.diameter[i], diameter);
+			TS_ASSERT_EQUALS(report.radius[i], radius);
+		}
+		
+		// Counting hops is the same as giving every edge a weight of 1
+		auto hops = component_diameters(g, path_length::hops);
+		auto unit_diameters = component_diameters(unit);
+		auto hop_report = eccentricities(g, path_length::hops);
+		auto unit_report = eccentricities(unit);
+		for (auto i = 0; i < components.size(); ++i){
+			TS_ASSERT_EQUALS(hops[i].diameter, unit_diameters[i].diameter);
+		}
+		for (auto u : g){
+			TS_ASSERT_EQUALS(hop_report.eccentricity.at(u), unit_report.eccentricity.at(u));
+		}
+		
+	}
+	
+	void testLabelPropagation(){
+		
+		weighted_graph<int> g;
+		std::vector<int> block;
+		
+		// Heavy cliques of at least two vertices, some joined to the one before by a light edge
+		auto r = (std::rand()%8) + 1;
+		auto n = 0;
+		for (auto b = 0; b < r; ++b){
+			auto size = (std::rand()%7) + 2;
+			for (auto i = 0; i < size; ++i){
+				g.add_vertex(n + i);
+				block.push_back(b);
+			}
+			for (auto i = 0; i < size; ++i){
+				for (auto j = i + 1; j < size; ++j) g.add_edge(n + i, n + j, std::rand()%10 + 10);
+			}
+			if (b > 0 && std::rand()%2 == 0) g.add_edge(n, n - 1, 1);
+			n += size;
+		}
+		
+		thread_pool pool(1);
+		label_propagation_options options;
+		options.seed = std::rand();
+		options.threshold = 0;
+		options.max_rounds = 1000;
+		auto partition = label_propagation(g, pool, options);
+		
+		TS_ASSERT_EQUALS(partition.sizes.size(), r);
+		for (auto u = 0; u < n; ++u){
+			for (auto v = 0; v < n; ++v){
+				TS_ASSERT_EQUALS(partition.community.at(u) == partition.community.at(v), block[u] == block[v]);
+			}
+		}
+		TS_ASSERT_EQUALS(partition.community.at(*g.begin()), 0);
+		if (r > 1) TS_ASSERT_LESS_THAN(0, modularity(g, partition.community));
+		
+		// The same seed gives the same communities
+		auto again = label_propagation(g, pool, options);
+		TS_ASSERT_EQUALS(again.community, partition.community);
+		TS_ASSERT_EQUALS(again.rounds, partition.rounds);
+		
+	}
+	
+	void testGraphColoring(){
+		
+		weighted_graph<int> g;
+		
+		auto r = (std::rand()%60) + 1;
+		
+		for (auto i = 0; i < r; ++i){
+			g.add_vertex(i);
+		}
+		
+		for (auto i = 0; i < 3*r; ++i){
+			auto u = std::rand()%r;
+			auto v = std::rand()%r;
+			if (u != v && !g.are_adjacent(u, v)) g.add_edge(u, v, std::rand()%10 + 1);
+		}
+		
+		auto degeneracy = core_numbers(g).degeneracy;
+		thread_pool pool(4);
+		for (auto order : {coloring_order::largest_degree_first, coloring_order::smallest_last}){
+			auto greedy = color_graph(g, pool, coloring_method::greedy, order, 3);
+			auto jones_plassmann = color_graph(g, pool, coloring_method::jones_plassmann, order, 3);
+			auto speculative = color_graph(g, pool, coloring_method::speculative, order, 3);
+			
+			// Jones and Plassmann choose exactly the colors the sequential pass does
+			TS_ASSERT_EQUALS(jones_plassmann.color, greedy.color);
+			TS_ASSERT_EQUALS(greedy.rounds, 0);
+			for (auto u : g){
+				for (auto n_it = g.neighbours_begin(u); n_it != g.neighbours_end(u); ++n_it){
+					TS_ASSERT_DIFFERS(greedy.color_of(u), greedy.color_of(n_it->first));
+					TS_ASSERT_DIFFERS(speculative.color_of(u), speculative.color_of(n_it->first));
+				}
+			}
+			if (order == coloring_order::smallest_last) TS_ASSERT_LESS_THAN_EQUALS(greedy.colors, degeneracy + 1);
+			
+			// Vertices that are not in the graph have no color
+			TS_ASSERT_THROWS_ANYTHING(greedy.color_of(r));
+			TS_ASSERT_THROWS_ANYTHING(greedy.color_of(-1));
+		}
+		
+	}
+	
+	void testRandomWalks(){
+		
+		weighted_graph<int> g;
+		
+		auto r = (std::rand()%30) + 2;
+		
+		for (auto i = 0; i < r; ++i){
+			g.add_vertex(i);
+		}
+		
+		for (auto i = 0; i < 2*r; ++i){
+			auto u = std::rand()%r;
+			auto v = std::rand()%r;
+			if (u != v && !g.are_adjacent(u, v)) g.add_edge(u, v, std::rand()%10 + 1);
+		}
+		
+		walk_options options;
+		options.length = 15;
+		options.walks_per_vertex = 3;
+		options.seed = std::rand();
+		options.batch_walks = 4;
+		
+		for (auto second_order : {false, true}){
+			if (second_order){
+				options.p = 0.5;
+				options.q = 2;
+			}
+			thread_pool one(1);
+			thread_pool four(4);
+			auto walks = random_walks(g, one, options);
+			
+			// The walks depend only on the seed, not on how many workers take them
+			TS_ASSERT_EQUALS(random_walks(g, four, options), walks);
+			TS_ASSERT_EQUALS(walks.size(), r * options.walks_per_vertex);
+			for (auto w = 0; w < walks.size(); ++w){
+				TS_ASSERT_EQUALS(walks[w][0], w % r);
+				TS_ASSERT_EQUALS(walks[w].size(), g.degree(walks[w][0]) == 0 ? 1 : options.length);
+				for (auto i = 1; i < walks[w].size(); ++i) TS_ASSERT(g.are_adjacent(walks[w][i - 1], walks[w][i]));
+			}
+		}
+		
+		// Neighbours are drawn in proportion to the weight of the edge to them
+		weighted_graph<int> star;
+		star.add_vertex(0);
+		for (auto i = 1; i <= 4; ++i){
+			star.add_vertex(i);
+			star.add_edge(0, i, i);
+		}
+		thread_pool pool(2);
+		csr_graph<int> c(star);
+		alias_tables tables(c, pool);
+		walk_random rng{42};
+		std::vector<int> drawn(5, 0);
+		for (auto i = 0; i < 100000; ++i) ++drawn[c.neighbours_begin(0)[tables.draw(c, 0, rng)]];
+		for (auto i = 1; i <= 4; ++i) TS_ASSERT_DELTA(drawn[i] / 100000.0, i / 10.0, 0.01);
+		
+		// Settings that could leave a walk stuck are turned away before any walking starts
+		walk_options stuck;
+		stuck.p = 0;
+		TS_ASSERT_THROWS_ANYTHING(random_walks(star, pool, stuck));
+		stuck.p = 1;
+		stuck.q = -1;
+		TS_ASSERT_THROWS_ANYTHING(random_walks(star, pool, stuck));
+		star.set_edge_weight(0, 1, -1);
+		TS_ASSERT_THROWS_ANYTHING(random_walks(star, pool));
+		
+	}
+	
+	void testBoundedDijkstras(){
+		
+		weighted_graph<int> g;
+		
+		auto r = (std::rand()%40) + 1;
+		
+		for (auto i = 0; i < r; ++i){
+			g.add_vertex(i);
+		}
+		
+		for (auto i = 0; i < 2*r; ++i){
+			auto u = std::rand()%r;
+			auto v = std::rand()%r;
+			if (u != v && !g.are_adjacent(u, v)) g.add_edge(u, v, std::rand()%10 + 1);
+		}
+		
+		csr_graph<int> c(g);
+		traversal_workspace ws;
+		std::vector<std::pair<int, int>> found;
+		for (auto v : g){
+			auto all = dijkstras(g, v);
+			std::vector<int> distances;
+			for (auto d : all) if (d.second != std::numeric_limits<int>::max()) distances.push_back(d.second);
+			std::sort(distances.begin(), distances.end());
+			
+			auto radius = std::rand()%20;
+			dijkstras_within(c, v, radius, ws, found);
+			TS_ASSERT_EQUALS(found.size(), std::upper_bound(distances.begin(), distances.end(), radius) - distances.begin());
+			TS_ASSERT_EQUALS(found[0].first, v);
+			for (auto i = 0; i < found.size(); ++i){
+				TS_ASSERT_EQUALS(found[i].second, all.at(found[i].first));
+				if (i > 0) TS_ASSERT_LESS_THAN_EQUALS(found[i - 1].second, found[i].second);
+			}
+			
+			auto k = std::rand()%10 + 1;
+			k_nearest(c, v, k, ws, found);
+			TS_ASSERT_EQUALS(found.size(), std::min<int>(k, distances.size()));
+			for (auto i = 0; i < found.size(); ++i){
+				TS_ASSERT_EQUALS(found[i].second, distances[i]);
+				TS_ASSERT_EQUALS(found[i].second, all.at(found[i].first));
+			}
+			
+			k_nearest(c, v, -(std::rand()%3), ws, found);
+			TS_ASSERT(found.empty());
+		}
+		
+	}
+	
+	void testDynamicShortestPaths(){
+		
+		weighted_graph<int> g;
+		
+		auto r = (std::rand()%30) + 2;
+		
+		for (auto i = 0; i < r; ++i){
+			g.add_vertex(i);
+		}
+		
+		for (auto i = 0; i < 2*r; ++i){
+			auto u = std::rand()%r;
+			auto v = std::rand()%r;
+			if (u != v && !g.are_adjacent(u, v)) g.add_edge(u, v, std::rand()%10 + 1);
+		}
+		
+		auto other = std::rand()%(r - 1) + 1;
+		dynamic_shortest_paths<int> paths(g, {0, other});
+		
+		for (auto step = 0; step < 100; ++step){
+			auto u = std::rand()%r;
+			auto v = std::rand()%r;
+			auto change = std::rand()%3;
+			if (u == v) continue;
+			if (change == 0 && !g.are_adjacent(u, v)) g.add_edge(u, v, std::rand()%10 + 1);
+			if (change == 1 && g.are_adjacent(u, v)) g.remove_edge(u, v);
+			if (change == 2 && g.are_adjacent(u, v)) g.set_edge_weight(u, v, std::rand()%10 + 1);
+			
+			for (auto source : {0, other}){
+				for (auto d : dijkstras(g, source)) TS_ASSERT_EQUALS(paths.distance(source, d.first), d.second);
+			}
+			TS_ASSERT_LESS_THAN_EQUALS(paths.last_touched(), 2 * r);
+		}
+		
+		// A vertex added later starts out unreachable, and a source that is removed is dropped
+		g.add_vertex(r);
+		TS_ASSERT_EQUALS(paths.distance(0, r), std::numeric_limits<int>::max());
+		g.remove_vertex(other);
+		TS_ASSERT_THROWS_ANYTHING(paths.distances(other));
+		for (auto d : dijkstras(g, 0)) TS_ASSERT_EQUALS(paths.distance(0, d.first), d.second);
+		
+	}
+	
+	void testKShortestPaths(){
+		
+		weighted_graph<int> g;
+		
+		auto r = (std::rand()%8) + 2;
+		
+		for (auto i = 0; i < r; ++i){
+			g.add_vertex(i);
+		}
+		
+		for (auto i = 0; i < 2*r; ++i){
+			auto u = std::rand()%r;
+			auto v = std::rand()%r;
+			if (u != v && !g.are_adjacent(u, v)) g.add_edge(u, v, std::rand()%10 + 1);
+		}
+		
+		// Every loopless path from 0 to the last vertex, by brute force
+		auto target = r - 1;
+		std::vector<int> lengths;
+		std::vector<bool> on_path(r, false);
+		auto extend = [&](auto& self, int u, int length) -> void {
+			if (u == target){
+				lengths.push_back(length);
+				return;
+			}
+			on_path[u] = true;
+			for (auto n_it = g.cneighbours_begin(u); n_it != g.cneighbours_end(u); ++n_it){
+				if (!on_path[n_it->first]) self(self, n_it->first, length + n_it->second);
+			}
+			on_path[u] = false;
+		};
+		extend(extend, 0, 0);
+		std::sort(lengths.begin(), lengths.end());
+		
+		auto k = std::rand()%20 + 1;
+		auto paths = k_shortest_paths(g, 0, target, k);
+		TS_ASSERT_EQUALS(paths.size(), std::min<int>(k, lengths.size()));
+		std::set<std::vector<int>> distinct;
+		for (auto i = 0; i < paths.size(); ++i){
+			TS_ASSERT_EQUALS(paths[i].length, lengths[i]);
+			TS_ASSERT_EQUALS(paths[i].vertices.front(), 0);
+			TS_ASSERT_EQUALS(paths[i].vertices.back(), target);
+			auto length = 0;
+			for (auto j = 0; j + 1 < paths[i].vertices.size(); ++j){
+				TS_ASSERT(g.are_adjacent(paths[i].vertices[j], paths[i].vertices[j + 1]));
+				length += g.get_edge_weight(paths[i].vertices[j], paths[i].vertices[j + 1]);
+			}
+			TS_ASSERT_EQUALS(length, paths[i].length);
+			std::set<int> visited(paths[i].vertices.begin(), paths[i].vertices.end());
+			TS_ASSERT_EQUALS(visited.size(), paths[i].vertices.size());
+			distinct.insert(paths[i].vertices);
+		}
+		TS_ASSERT_EQUALS(distinct.size(), paths.size());
+		
+	}
+	
+	void testDistanceMatrix(){
+		
+		weighted_graph<int> g;
+		
+		auto r = (std::rand()%40) + 1;
+		
+		for (auto i = 0; i < r; ++i){
+			g.add_vertex(i);
+		}
+		
+		for (auto i = 0; i < 2*r; ++i){
+			auto u = std::rand()%r;
+			auto v = std::rand()%r;
+			if (u != v && !g.are_adjacent(u, v)) g.add_edge(u, v, std::rand()%10 + 1);
+		}
+		
+		thread_pool pool(4);
+		std::vector<int> sources;
+		for (auto i = 0; i < 10; ++i) sources.push_back(std::rand()%r);
+		sources.push_back(r); // not in the graph
+		
+		auto all = distances_between(g, sources, pool);
+		TS_ASSERT_EQUALS(all.targets.size(), r);
+		TS_ASSERT_EQUALS(all.distances.size(), sources.size() * r);
+		for (auto i = 0; i < sources.size(); ++i){
+			for (auto j = 0; j < r; ++j){
+				auto expected = g.has_vertex(sources[i]) ? dijkstras(g, sources[i]).at(all.targets[j]) : std::numeric_limits<int>::max();
+				TS_ASSERT_EQUALS(all.at(i, j), expected);
+				TS_ASSERT_EQUALS(all.row(i)[j], expected);
+			}
+		}
+		
+		// A few targets, repeated or missing ones included
+		std::vector<int> targets = {std::rand()%r, std::rand()%r, r + 1};
+		targets.push_back(targets[0]);
+		auto some = distances_between(g, sources, targets, pool);
+		TS_ASSERT_EQUALS(some.distances.size(), sources.size() * targets.size());
+		for (auto i = 0; i < sources.size(); ++i){
+			for (auto j = 0; j < targets.size(); ++j){
+				auto expected = g.has_vertex(sources[i]) && g.has_vertex(targets[j]) ? dijkstras(g, sources[i]).at(targets[j]) : std::numeric_limits<int>::max();
+				TS_ASSERT_EQUALS(some.at(i, j), expected);
+			}
+		}
+		
+	}
+	
+	void testTrackedConnectivity(){
+		
+		weighted_graph<int> g;
+		g.track_connectivity(true);
+		
+		TS_ASSERT(is_connected(g));
+		TS_ASSERT_EQUALS(g.num_components(), 0);
+		
+		auto r = (std::rand()%20) + 5;
+		
+		for (auto i = 0; i < r; ++i){
+			g.add_vertex(i);
+		}
+		
+		TS_ASSERT_EQUALS(g.num_components(), r);
+		
+		std::vector<int> vertices(g.begin(), g.end());
+		auto tree = random_tree(vertices);
+		
+		for (int i = 0; i < tree.size(); ++i){
+			g.add_edge(tree[i].first, tree[i].second, (std::rand()%10) + 1);
+			TS_ASSERT_EQUALS(g.num_components(), r - i - 1);
+			TS_ASSERT(g.same_component(tree[i].first, tree[i].second));
+		}
+		
+		TS_ASSERT(is_connected(g));
+		
+		// Removing a tree edge splits the graph, which the lazy rebuild has to notice
+		auto cut = tree[std::rand()%tree.size()];
+		g.remove_edge(cut.first, cut.second);
+		TS_ASSERT(!is_connected(g));
+		TS_ASSERT_EQUALS(g.num_components(), 2);
+		TS_ASSERT(!g.same_component(cut.first, cut.second));
+		
+		g.add_edge(cut.first, cut.second, 1);
+		TS_ASSERT(is_connected(g));
+		
+		g.remove_vertex(cut.first);
+		TS_ASSERT_EQUALS(g.num_components(), connected_components(g).size());
+		
+		g.track_connectivity(false);
+		TS_ASSERT_EQUALS(g.num_components(), connected_components(g).size());
+		
+	}
+	
+	void testDynamicConnectivity(){
+		
+		weighted_graph<int> g;
+		
+		auto r = (std::rand()%30) + 5;
+		
+		for (auto i = 0; i < r; ++i){
+			g.add_vertex(i);
+		}
+		
+		dynamic_connectivity<int> connectivity(g);
+		
+		// Mix insertions with deletions, including vertex removals that take their edges with them
+		for (auto step = 0; step < 500; ++step){
+			auto u = std::rand()%r;
+			auto v = std::rand()%r;
+			auto op = std::rand()%10;
+			if (op < 5){
+				if (g.has_vertex(u) && g.has_vertex(v) && u != v && !g.are_adjacent(u, v)) g.add_edge(u, v, 1);
+			}
+			else if (op < 9){
+				if (g.are_adjacent(u, v)) g.remove_edge(u, v);
+			}
+			else if (g.has_vertex(u)){
+				g.remove_vertex(u);
+			}
+			else {
+				g.add_vertex(u);
+			}
+			
+			auto labelling = component_labels(g);
+			TS_ASSERT_EQUALS(connectivity.num_components(), labelling.sizes.size());
+			for (auto a : g){
+				TS_ASSERT_EQUALS(connectivity.component_size(a), labelling.sizes[labelling.component.at(a)]);
+				for (auto b : g){
+					TS_ASSERT_EQUALS(connectivity.connected(a, b), labelling.component.at(a) == labelling.component.at(b));
+				}
+			}
+		}
+		
+	}
+	
+	void testRemoveVertexByReference(){
+		
+		weighted_graph<std::string> g;
+		
+		auto r = (std::rand()%20) + 5;
+		
+		for (auto i = 0; i < r; ++i){
+			g.add_vertex(std::to_string(i));
+		}
+		
+		for (auto i = 0; i < 2*r; ++i){
+			auto u = std::to_string(std::rand()%r);
+			auto v = std::to_string(std::rand()%r);
+			if (u != v && !g.are_adjacent(u, v)) g.add_edge(u, v, 1);
+		}
+		
+		// Checks that every edge reported removed is already gone from both ends, and no other is
+		struct checker : graph_observer<std::string> {
+			const weighted_graph<std::string>& g;
+			int edges;
+			checker(const weighted_graph<std::string>& g) : g(g), edges(g.num_edges()) {}
+			void edge_removed(const std::string& u, const std::string& v, int) override {
+				TS_ASSERT(!g.are_adjacent(u, v));
+				TS_ASSERT(!g.are_adjacent(v, u));
+				TS_ASSERT_EQUALS(g.num_edges(), --edges);
+			}
+			void vertex_removed(const std::string& u) override {
+				TS_ASSERT(!g.has_vertex(u));
+			}
+		} check(g);
+		dynamic_connectivity<std::string> connectivity(g);
+		g.attach(&check);
+		
+		// The reference is to the graph's own copy of the vertex, which removal erases
+		while (g.num_vertices() > 0){
+			g.remove_vertex(*g.begin());
+			auto labelling = component_labels(g);
+			TS_ASSERT_EQUALS(connectivity.num_components(), labelling.sizes.size());
+		}
+		TS_ASSERT_EQUALS(g.num_edges(), 0);
+		g.detach(&check);
+		
+	}
+	
+	void testDynamicSpanningForest(){
+		
+		weighted_graph<int> g;
+		
+		auto r = (std::rand()%30) + 5;
+		
+		for (auto i = 0; i < r; ++i){
+			g.add_vertex(i);
+		}
+		
+		dynamic_spanning_forest<int> forest(g);
+		
+		// Weight changes both ways, on forest edges and others, mixed in with insertions and deletions
+		for (auto step = 0; step < 500; ++step){
+			auto u = std::rand()%r;
+			auto v = std::rand()%r;
+			auto op = std::rand()%10;
+			if (op < 4){
+				if (g.has_vertex(u) && g.has_vertex(v) && u != v) g.set_edge_weight(u, v, std::rand()%20 + 1);
+			}
+			else if (op < 6){
+				if (g.has_vertex(u) && g.has_vertex(v) && u != v && !g.are_adjacent(u, v)) g.add_edge(u, v, std::rand()%20 + 1);
+			}
+			else if (op < 9){
+				if (g.are_adjacent(u, v)) g.remove_edge(u, v);
+			}
+			else if (g.has_vertex(u)){
+				g.remove_vertex(u);
+			}
+			else {
+				g.add_vertex(u);
+			}
+			
+			auto expected = minimum_spanning_forest(g);
+			TS_ASSERT_EQUALS(forest.total_weight(), expected.total_weight());
+			TS_ASSERT_EQUALS(forest.num_edges(), expected.num_edges());
+			// Every forest edge is an edge of g, at its current weight
+			auto current = forest.forest();
+			for (auto a : current){
+				for (auto n_it = current.neighbours_begin(a); n_it != current.neighbours_end(a); ++n_it){
+					TS_ASSERT(forest.in_forest(a, n_it->first));
+					TS_ASSERT(g.are_adjacent(a, n_it->first));
+					TS_ASSERT_EQUALS(g.get_edge_weight(a, n_it->first), n_it->second);
+				}
+			}
+		}
+		
+	}
+	
+	void testComponentLabels(){
+		
+		weighted_graph<int> g;
+		int vert_total = 0;
+		
+		std::vector<std::vector<int>> components;
+		
+		auto num_components = std::rand()%10 + 2;
+		
+		for (auto i = 0; i < num_components; ++i){
+			
+			std::vector<int> component;
+			auto r = std::rand()%5 + 1;
+			for (auto j = vert_total; j < vert_total + r; ++j){
+				component.push_back(j);
+				g.add_vertex(j);
+			}
+			vert_total += component.size();
+			for (auto e : random_tree(component)){
+				g.add_edge(e.first, e.second, std::rand()%5 + 1);
+			}
+			components.push_back(component);
+			
+		}
+		
+		auto labelling = component_labels(g);
+		
+		TS_ASSERT_EQUALS(labelling.sizes.size(), components.size());
+		TS_ASSERT_EQUALS(labelling.component.size(), g.num_vertices());
+		
+		for (auto c : components){
+			auto label = labelling.component.at(c[0]);
+			TS_ASSERT_EQUALS(labelling.sizes[label], c.size());
+			for (auto v : c) TS_ASSERT_EQUALS(labelling.component.at(v), label);
+		}
+		
+		// Component ids follow the order connected_components lists the components in
+		auto computed_components = connected_components(g);
+		for (int i = 0; i < computed_components.size(); ++i){
+			TS_ASSERT_EQUALS(computed_components[i].num_vertices(), labelling.sizes[i]);
+			for (auto v : computed_components[i]) TS_ASSERT_EQUALS(labelling.component.at(v), i);
+		}
+		
+	}
+	
+	void testParallelComponentLabelsMatchesSequential(){
+		
+		weighted_graph<int> g;
+		
+		auto r = (std::rand()%500) + 1;
+		
+		for (auto i = 0; i < r; ++i){
+			g.add_vertex(i);
+		}
+		
+		for (auto i = 0; i < r; ++i){
+			auto u = std::rand()%r;
+			auto v = std::rand()%r;
+			if (!g.are_adjacent(u, v)) g.add_edge(u, v, std::rand()%10 + 1);
+		}
+		
+		auto expected = component_labels(g);
+		csr_graph<int> c(g);
+		
+		for (auto threads : {1, 4}){
+			thread_pool pool(threads);
+			auto labelling = parallel_component_labels(g, pool);
+			TS_ASSERT_EQUALS(labelling.component, expected.component);
+			TS_ASSERT_EQUALS(labelling.sizes, expected.sizes);
+			
+			// The frozen graph numbers its components differently, but must split the vertices the same way
+			auto ids = parallel_component_ids(c, pool);
+			for (auto u : g){
+				for (auto v : g){
+					TS_ASSERT_EQUALS(ids[c.index_of(u)] == ids[c.index_of(v)], expected.component.at(u) == expected.component.at(v));
+				}
+			}
+		}
+		
+	}
+	
+	void testParallelBreadthFirstLevels(){
+		
+		weighted_graph<int> g;
+		
+		auto r = (std::rand()%500) + 1;
+		
+		for (auto i = 0; i < r; ++i){
+			g.add_vertex(i);
+		}
+		
+		for (auto i = 0; i < r; ++i){
+			auto u = std::rand()%r;
+			auto v = std::rand()%r;
+			if (u != v && !g.are_adjacent(u, v)) g.add_edge(u, v, std::rand()%10 + 1);
+		}
+		
+		csr_graph<int> c(g);
+		auto start_vertex = std::rand()%r;
+		auto bf_order = breadth_first(c, start_vertex);
+		
+		for (auto threads : {1, 4}){
+			thread_pool pool(threads);
+			auto tree = parallel_breadth_first(c, start_vertex, pool);
+			
+			// Exactly the vertices breadth_first reaches get a level, and the levels never drop along its order
+			auto reached = 0;
+			for (auto u = 0; u < c.num_vertices(); ++u) if (tree.level[u] != -1) ++reached;
+			TS_ASSERT_EQUALS(reached, bf_order.size());
+			TS_ASSERT_EQUALS(tree.level[c.index_of(start_vertex)], 0);
+			TS_ASSERT_EQUALS(tree.parent[c.index_of(start_vertex)], c.index_of(start_vertex));
+			for (auto i = 1; i < bf_order.size(); ++i){
+				auto u = c.index_of(bf_order[i]);
+				TS_ASSERT(tree.level[u] >= tree.level[c.index_of(bf_order[i-1])]);
+				TS_ASSERT(g.are_adjacent(bf_order[i], c.vertex_at(tree.parent[u])));
+				TS_ASSERT_EQUALS(tree.level[tree.parent[u]], tree.level[u] - 1);
+			}
+		}
+		
+	}
+	
+	void testMultiSourceBreadthFirst(){
+		
+		weighted_graph<int> g;
+		
+		auto r = (std::rand()%300) + 1;
+		
+		for (auto i = 0; i < r; ++i){
+			g.add_vertex(i);
+		}
+		
+		for (auto i = 0; i < r; ++i){
+			auto u = std::rand()%r;
+			auto v = std::rand()%r;
+			if (u != v && !g.are_adjacent(u, v)) g.add_edge(u, v, std::rand()%10 + 1);
+		}
+		
+		// More sources than fit in one 64 bit batch, with a repeat and one that is not in the graph
+		std::vector<int> sources;
+		for (auto i = 0; i < 70; ++i){
+			sources.push_back(std::rand()%r);
+		}
+		sources.push_back(sources[0]);
+		sources.push_back(r);
+		
+		csr_graph<int> c(g);
+		auto distances = multi_source_distances(c, sources);
+		TS_ASSERT_EQUALS(multi_source_distances<4>(c, sources), distances);
+		auto summaries = multi_source_summaries<4>(g, sources);
+		thread_pool pool(1);
+		
+		for (auto i = 0; i < sources.size(); ++i){
+			// The levels of a single breadth first search are the hop distances
+			TS_ASSERT_EQUALS(distances[i], parallel_breadth_first(c, sources[i], pool).level);
+			
+			auto reached = g.has_vertex(sources[i]) ? breadth_first(g, sources[i]).size() : 0;
+			TS_ASSERT_EQUALS(summaries[i].reached, reached);
+			auto total = 0;
+			for (auto d : distances[i]) if (d > 0) total += d;
+			TS_ASSERT_EQUALS(summaries[i].total_distance, total);
+		}
+		
+	}
+	
 	void testDijkstrasEmptyGraph(){
 		
 		weighted_graph<int> g;
@@ -399,5 +1479,210 @@ public:
 		}
 	}
 
+	void testBiconnectedComponentsTree(){
+		
+		weighted_graph<int> g;
+		
+		auto r = (std::rand()%20) + 5;
+		
+		for (auto i = 0; i < r; ++i){
+			g.add_vertex(i);
+		}
+		
+		std::vector<int> vertices(g.begin(), g.end());
+		
+		for (auto e : random_tree(vertices)){
+			g.add_edge(e.first, e.second, (std::rand()%10) + 1);
+		}
+		
+		auto decomposition = biconnected_components(g);
+		
+		// Every edge of a tree is a bridge and its own block, and every non-leaf is an articulation point
+		TS_ASSERT_EQUALS(decomposition.bridges.size(), g.num_edges());
+		TS_ASSERT_EQUALS(decomposition.components.size(), g.num_edges());
+		for (auto e : decomposition.bridges) TS_ASSERT(g.are_adjacent(e.first, e.second));
+		
+		unsigned non_leaves = 0;
+		for (auto v : g) if (g.degree(v) > 1) ++non_leaves;
+		TS_ASSERT_EQUALS(decomposition.articulation_points.size(), non_leaves);
+		for (auto v : decomposition.articulation_points) TS_ASSERT(g.degree(v) > 1);
+		
+	}
+	
+	void testBiconnectedComponentsBlockCutTree(){
+		
+		weighted_graph<int> g;
+		auto vert_total = 0;
+		
+		std::vector<std::vector<int>> components;
+		
+		auto num_components = std::rand()%10 + 2;	
+		for (auto i = 0; i < num_components; ++i){
+			
+			std::vector<int> component;
+			auto r = std::rand()%5 + 3;
+			for (auto j = vert_total; j < vert_total + r; ++j){
+				component.push_back(j);
+			}
+			vert_total += component.size();
+			components.push_back(component);
+			
+		}
+		
+		for (auto c : components){
+			for (auto v : c) {
+				g.add_vertex(v);
+			}
+			
+			for (int i = 0; i < c.size(); ++i) g.add_edge(c[i], c[(i+1)%c.size()], std::rand()%10 + 1);
+		}
+		
+		auto expected_tree = random_block_cut_tree(components);
+		unsigned expected_cuts = 0;
+		
+		for (auto v : expected_tree){
+			if (v.isCut){
+				g.add_vertex(vert_total);
+				++expected_cuts;
+				
+				for (auto n = expected_tree.neighbours_begin(v); n != expected_tree.neighbours_end(v); ++n){
+					auto component = n->first.v;
+					g.add_edge(component[0], vert_total, std::rand()%10 + 1);
+					g.add_edge(component[1], vert_total, std::rand()%10 + 1);
+				}
+				
+				++vert_total;
+			}
+		}
+		
+		auto decomposition = biconnected_components(g);
+		auto computed_tree = decomposition.block_cut_tree;
+		
+		TS_ASSERT(decomposition.bridges.empty());
+		TS_ASSERT_EQUALS(decomposition.articulation_points.size(), expected_cuts);
+		TS_ASSERT_EQUALS(decomposition.components.size(), components.size());
+		TS_ASSERT_EQUALS(computed_tree.num_vertices(), expected_tree.num_vertices());
+		TS_ASSERT_EQUALS(computed_tree.num_edges(), expected_tree.num_edges());
+		TS_ASSERT(is_connected(computed_tree));
+		
+		// Each block holds one of the generated components plus the cut vertices attached to it
+		for (auto v : computed_tree){
+			if (!v.isCut){
+				std::vector<int> source_component;
+				for (auto c : components){
+					if (std::find(v.v.begin(), v.v.end(), c[0]) != v.v.end()) source_component = c;
+				}
+				TS_ASSERT(!source_component.empty());
+				for (auto u : source_component) TS_ASSERT(std::find(v.v.begin(), v.v.end(), u) != v.v.end());
+				TS_ASSERT_EQUALS(v.v.size(), source_component.size() + computed_tree.degree(v));
+			}
+		}
+		
+	}
+	
+	void testArticulationPointsDeepPath(){
+		
+		weighted_graph<int> g;
+		
+		auto r = 100000;
+		
+		for (auto i = 0; i < r; ++i){
+			g.add_vertex(i);
+			if (i > 0) g.add_edge(i - 1, i, 1);
+		}
+		
+		// Deep enough to overflow a recursive depth first search
+		TS_ASSERT_EQUALS(articulation_points(g).size(), r - 2);
+		
+	}
+	
+	void testParallelBiconnectedComponentsMatchesSequential(){
+		
+		weighted_graph<int> g;
+		
+		auto r = (std::rand()%200) + 20;
+		
+		for (auto i = 0; i < r; ++i){
+			g.add_vertex(i);
+		}
+		
+		// A sparse random graph has a good mix of bridges, cycles and isolated vertices
+		for (auto i = 0; i < r; ++i){
+			auto u = std::rand()%r;
+			auto v = std::rand()%r;
+			if (u != v && !g.are_adjacent(u, v)) g.add_edge(u, v, std::rand()%10 + 1);
+		}
+		
+		auto expected = biconnected_components(g);
+		
+		for (auto threads : {1, 4}){
+			thread_pool pool(threads);
+			auto computed = parallel_biconnected_components(g, pool);
+			
+			TS_ASSERT_EQUALS(computed.articulation_points, expected.articulation_points);
+			TS_ASSERT_EQUALS(parallel_articulation_points(g, pool), articulation_points(g));
+			
+			auto expected_components = expected.components;
+			auto computed_components = computed.components;
+			std::sort(expected_components.begin(), expected_components.end());
+			std::sort(computed_components.begin(), computed_components.end());
+			TS_ASSERT_EQUALS(computed_components, expected_components);
+			
+			std::set<std::pair<int, int>> expected_bridges;
+			std::set<std::pair<int, int>> computed_bridges;
+			for (auto e : expected.bridges) expected_bridges.insert({std::min(e.first, e.second), std::max(e.first, e.second)});
+			for (auto e : computed.bridges) computed_bridges.insert({std::min(e.first, e.second), std::max(e.first, e.second)});
+			TS_ASSERT_EQUALS(computed_bridges, expected_bridges);
+			
+			TS_ASSERT_EQUALS(computed.block_cut_tree.num_vertices(), expected.block_cut_tree.num_vertices());
+			TS_ASSERT_EQUALS(computed.block_cut_tree.num_edges(), expected.block_cut_tree.num_edges());
+		}
+		
+	}
+	
+	void testContractionHierarchyEmptyGraph(){
+		
+		weighted_graph<int> g;
+		contraction_hierarchy<int> ch(g);
+		TS_ASSERT_EQUALS(ch.num_shortcuts(), 0);
+		TS_ASSERT_EQUALS(ch.distance(0, 1), std::numeric_limits<int>::max());
+		
+	}
+	
+	void testContractionHierarchyMatchesDijkstras(){
+		
+		weighted_graph<int> g;
+		
+		auto r = (std::rand()%40) + 10;
+		
+		for (auto i = 0; i < r; ++i){
+			g.add_vertex(i);
+		}
+		
+		// Leave the last few vertices out of the tree so some queries have no path
+		std::vector<int> vertices;
+		for (auto i = 0; i < r - 3; ++i) vertices.push_back(i);
+		
+		for (auto e : random_tree(vertices)){
+			g.add_edge(e.first, e.second, (std::rand()%10) + 1);
+		}
+		
+		for (auto e : random_tree(vertices)){
+			if (!g.are_adjacent(e.first, e.second)){
+				g.add_edge(e.first, e.second, (std::rand()%10) + 1);
+			}
+		}
+		
+		contraction_hierarchy<int> ch(g);
+		
+		for (auto s : g){
+			auto expected = dijkstras(g, s);
+			for (auto t : g){
+				TS_ASSERT_EQUALS(ch.distance(s, t), expected[t]);
+			}
+		}
+		
+	}
+
 };
 
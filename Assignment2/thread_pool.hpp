@@ -0,0 +1,188 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <cstdint>
+#include <algorithm>
+#include <functional>
+#include <condition_variable>
+
+// A fixed set of worker threads for the parallel graph algorithms.
+// The calling thread takes part in every job as worker 0, so a pool of size 1 runs everything
+// inline. Jobs may not be nested: a job must not call back into the pool that is running it.
+// parallel_for balances its loops by work stealing: every worker starts with an even share of
+// the indices, and a worker that runs out takes half of whatever another worker has left.
+class thread_pool {
+
+	private:
+
+	// The indices a worker has yet to claim, packed as begin << 32 | end so that the owner taking
+	// from the front and thieves taking from the back can both update it with one compare-and-swap.
+	// Padded to a cache line so that neighbouring workers' claims do not contend.
+	struct alignas(64) work_range {
+		std::atomic<std::uint64_t> span{0};
+	};
+
+	std::vector<std::thread> workers;
+	std::mutex lock;
+	std::condition_variable wake;
+	std::condition_variable finished;
+	std::function<void(int)> job;
+	unsigned generation{0}; // bumped for every job so sleeping workers can tell a new one has arrived
+	int running{0};
+	bool stopping{false};
+	std::unique_ptr<work_range[]> ranges; // one per worker, reused by every parallel_for
+
+	void work(int);
+	bool claim(int, int, int&, int&);
+	bool steal(int);
+
+	public:
+
+	explicit thread_pool(int threads = std::max(1u, std::thread::hardware_concurrency()));
+	~thread_pool();
+
+	thread_pool(const thread_pool&) = delete;
+	thread_pool& operator=(const thread_pool&) = delete;
+
+	int size() const;
+
+	void run(const std::function<void(int)>&);
+
+	template <typename F> void parallel_for(int, int, int, F);
+
+};
+
+inline thread_pool::thread_pool(int threads) : ranges(new work_range[std::max(1, threads)]) {
+	for (int i = 1; i < threads; ++i) workers.emplace_back(&thread_pool::work, this, i);
+}
+
+inline thread_pool::~thread_pool() {
+	{
+		std::lock_guard<std::mutex> guard(lock);
+		stopping = true;
+	}
+	wake.notify_all();
+	for (auto& t : workers) t.join();
+}
+
+inline int thread_pool::size() const { return workers.size() + 1; }
+
+inline void thread_pool::work(int index) {
+	unsigned seen = 0;
+	while (true) {
+		std::unique_lock<std::mutex> guard(lock);
+		wake.wait(guard, [&]{ return stopping || generation != seen; });
+		if (stopping) return;
+		seen = generation;
+		guard.unlock();
+
+		job(index);
+
+		guard.lock();
+		if (--running == 0) finished.notify_one();
+	}
+}
+
+// Runs f(worker) once on every worker, and returns when they have all finished.
+inline void thread_pool::run(const std::function<void(int)>& f) {
+	if (workers.empty()) {
+		f(0);
+		return;
+	}
+	{
+		std::lock_guard<std::mutex> guard(lock);
+		job = f;
+		running = workers.size();
+		++generation;
+	}
+	wake.notify_all();
+	f(0);
+	std::unique_lock<std::mutex> guard(lock);
+	finished.wait(guard, [&]{ return running == 0; });
+}
+
+// Takes up to grain indices from the front of worker's own range. Returns false once it is empty.
+inline bool thread_pool::claim(int worker, int grain, int& begin, int& end) {
+	std::uint64_t span = ranges[worker].span.load(std::memory_order_acquire);
+	while (true) {
+		std::uint32_t first = span >> 32, last = span;
+		if (first >= last) return false;
+		std::uint32_t split = std::min<std::uint64_t>(last, std::uint64_t(first) + grain);
+		// Fails, reloading span, if a thief has cut the back off the range in the meantime
+		if (ranges[worker].span.compare_exchange_weak(span, std::uint64_t(split) << 32 | last, std::memory_order_acq_rel)) {
+			begin = first;
+			end = split;
+			return true;
+		}
+	}
+}
+
+// Moves the back half of another worker's range into thief's own, which must be empty.
+// Returns false if every other worker has run out as well.
+inline bool thread_pool::steal(int thief) {
+	for (int i = 1; i < size(); ++i) {
+		int victim = (thief + i) % size();
+		std::uint64_t span = ranges[victim].span.load(std::memory_order_acquire);
+		while (true) {
+			std::uint32_t first = span >> 32, last = span;
+			if (first >= last) break;
+			std::uint32_t middle = first + (last - first) / 2;
+			if (ranges[victim].span.compare_exchange_weak(span, std::uint64_t(first) << 32 | middle, std::memory_order_acq_rel)) {
+				// Nobody steals from an empty range, so the thief's own range can simply be overwritten
+				ranges[thief].span.store(std::uint64_t(middle) << 32 | last, std::memory_order_release);
+				return true;
+			}
+		}
+	}
+	return false;
+}
+
+// Calls f(begin, end, worker) over chunks of at most grain indices covering [first, last).
+// Each worker works through its own share of the indices and then steals from the others, so
+// uneven chunks balance out without every claim going through one shared counter.
+template <typename F> void thread_pool::parallel_for(int first, int last, int grain, F f) {
+	if (last <= first) return;
+	grain = std::max(1, grain);
+	// Ranges are kept relative to first, so they fit the unsigned halves of the packed span
+	const std::uint64_t count = std::uint64_t(std::int64_t(last) - first);
+	for (int w = 0; w < size(); ++w) {
+		std::uint64_t begin = count * w / size(), end = count * (w + 1) / size();
+		ranges[w].span.store(begin << 32 | end, std::memory_order_relaxed);
+	}
+	run([&](int worker) {
+		int begin, end;
+		do {
+			while (claim(worker, grain, begin, end)) f(first + begin, first + end, worker);
+		} while (steal(worker));
+	});
+}
+
+// Sorts [first, last) by comp, each worker sorting an even slice before the slices are merged
+// pairwise, with the merges of each round running in parallel.
+template <typename iterator, typename compare = std::less<>>
+void parallel_sort(iterator first, iterator last, thread_pool& pool, compare comp = compare()) {
+	const int parts = pool.size();
+	const auto n = last - first;
+	if (parts == 1 || n < 4096) {
+		std::sort(first, last, comp);
+		return;
+	}
+	std::vector<iterator> bounds(parts + 1);
+	for (int i = 0; i <= parts; ++i) bounds[i] = first + n * i / parts;
+	pool.run([&](int worker) { std::sort(bounds[worker], bounds[worker + 1], comp); });
+	for (int width = 1; width < parts; width *= 2) {
+		pool.parallel_for(0, (parts + 2 * width - 1) / (2 * width), 1, [&](int begin, int end, int) {
+			for (int i = begin; i < end; ++i) {
+				int low = i * 2 * width, middle = std::min(low + width, parts), high = std::min(low + 2 * width, parts);
+				if (middle < high) std::inplace_merge(bounds[low], bounds[middle], bounds[high], comp);
+			}
+		});
+	}
+}
+
+#endif
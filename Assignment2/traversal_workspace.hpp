@@ -0,0 +1,96 @@
+#ifndef TRAVERSAL_WORKSPACE_H
+#define TRAVERSAL_WORKSPACE_H
+
+#include <vector>
+#include <limits>
+#include <utility>
+#include <algorithm>
+
+// Scratch space for repeated traversals of a csr_graph with n dense ids, so that once it has been
+// sized a query allocates nothing. A vertex counts as seen or settled only if its stamp matches the
+// current epoch, which makes reset O(1): it just starts a new epoch. The stamps are only really
+// cleared when the epoch counter wraps around, once every few billion resets.
+class traversal_workspace {
+
+	private:
+
+	std::vector<unsigned> seen_stamp;
+	std::vector<unsigned> settled_stamp;
+	std::vector<int> distances; // only meaningful where seen_stamp is current
+	std::vector<int> parents;
+	unsigned epoch{1};
+
+	public:
+
+	std::vector<int> frontier; // a stack or a queue of ids, whichever the traversal needs
+	std::vector<std::pair<int, int>> heap; // (distance, id), kept as a min-heap by the traversal
+
+	explicit traversal_workspace(int = 0);
+
+	int size() const;
+	void resize(int);
+	void reset();
+
+	bool seen(int) const;
+	bool mark_seen(int);
+	bool settled(int) const;
+	void settle(int);
+
+	int distance(int) const;
+	int parent(int) const;
+	void set_distance(int, int, int);
+
+};
+
+inline traversal_workspace::traversal_workspace(int n) { resize(n); }
+
+inline int traversal_workspace::size() const { return seen_stamp.size(); }
+
+// Makes room for n ids. Only this allocates, and only when n is larger than before.
+inline void traversal_workspace::resize(int n) {
+	if (n <= size()) return;
+	seen_stamp.resize(n, 0);
+	settled_stamp.resize(n, 0);
+	distances.resize(n);
+	parents.resize(n);
+	frontier.reserve(n);
+}
+
+// Forgets everything the last traversal marked, keeping every buffer's capacity.
+inline void traversal_workspace::reset() {
+	if (++epoch == 0) {
+		std::fill(seen_stamp.begin(), seen_stamp.end(), 0);
+		std::fill(settled_stamp.begin(), settled_stamp.end(), 0);
+		epoch = 1;
+	}
+	frontier.clear();
+	heap.clear();
+}
+
+inline bool traversal_workspace::seen(int u) const { return seen_stamp[u] == epoch; }
+
+// Marks u as seen. Returns true if it had not been seen already.
+inline bool traversal_workspace::mark_seen(int u) {
+	if (seen_stamp[u] == epoch) return false;
+	seen_stamp[u] = epoch;
+	return true;
+}
+
+inline bool traversal_workspace::settled(int u) const { return settled_stamp[u] == epoch; }
+
+inline void traversal_workspace::settle(int u) { settled_stamp[u] = epoch; }
+
+// Returns the distance recorded for u since the last reset, or the maximum int if there is none.
+inline int traversal_workspace::distance(int u) const { return seen(u) ? distances[u] : std::numeric_limits<int>::max(); }
+
+// Returns the id u was reached from, u itself for the source, or -1 if u has not been reached.
+inline int traversal_workspace::parent(int u) const { return seen(u) ? parents[u] : -1; }
+
+// Records that u is at distance d, reached from p, and marks it as seen.
+inline void traversal_workspace::set_distance(int u, int d, int p) {
+	seen_stamp[u] = epoch;
+	distances[u] = d;
+	parents[u] = p;
+}
+
+#endif
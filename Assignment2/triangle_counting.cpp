@@ -0,0 +1,174 @@
+#ifndef TRIANGLE_COUNTING
+#define TRIANGLE_COUNTING
+
+#include <vector>
+#include <atomic>
+#include <numeric>
+#include <algorithm>
+#include <unordered_map>
+#include "weighted_graph.hpp"
+#include "csr_graph.hpp"
+#include "thread_pool.hpp"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+// Calls on_match(x) for every x in both of the ascending, duplicate-free arrays a and b, and
+// returns how many there were. With SSE2 the arrays are merged four elements against four: each
+// block of a is compared with all four rotations of the block of b in one go, and whichever block
+// ends lower is stepped past. The last few elements fall through to a plain scalar merge.
+template <typename F>
+int intersect_sorted(const int* a, int a_size, const int* b, int b_size, F on_match) {
+	int i = 0, j = 0, common = 0;
+#if defined(__SSE2__)
+	while (i + 4 <= a_size && j + 4 <= b_size) {
+		__m128i block_a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+		__m128i block_b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + j));
+		__m128i equal = _mm_or_si128(
+			_mm_or_si128(_mm_cmpeq_epi32(block_a, block_b), _mm_cmpeq_epi32(block_a, _mm_shuffle_epi32(block_b, _MM_SHUFFLE(0, 3, 2, 1)))),
+			_mm_or_si128(_mm_cmpeq_epi32(block_a, _mm_shuffle_epi32(block_b, _MM_SHUFFLE(1, 0, 3, 2))), _mm_cmpeq_epi32(block_a, _mm_shuffle_epi32(block_b, _MM_SHUFFLE(2, 1, 0, 3)))));
+		// One bit per element of a's block that appears somewhere in b's
+		int mask = _mm_movemask_ps(_mm_castsi128_ps(equal));
+		for (; mask; mask &= mask - 1) {
+			++common;
+			on_match(a[i + __builtin_ctz(mask)]);
+		}
+		int a_last = a[i + 3], b_last = b[j + 3];
+		if (a_last <= b_last) i += 4;
+		if (b_last <= a_last) j += 4;
+	}
+#endif
+	while (i < a_size && j < b_size) {
+		if (a[i] < b[j]) ++i;
+		else if (b[j] < a[i]) ++j;
+		else {
+			++common;
+			on_match(a[i]);
+			++i;
+			++j;
+		}
+	}
+	return common;
+}
+
+// The edges of a csr_graph each kept once, at the end with the lower (degree, id) rank, and pointing
+// at the other end. Ids are renumbered by rank, so every list is sorted by rank as well. Each
+// triangle is then found exactly once, from its lowest ranked corner, and no vertex has more than
+// O(sqrt E) edges to scan, however high its degree was.
+struct oriented_adjacency {
+	std::vector<int> offsets;
+	std::vector<int> targets;
+	std::vector<int> id_of; // rank -> id of the csr_graph
+
+	template <typename vertex> explicit oriented_adjacency(const csr_graph<vertex>&);
+
+	int size() const { return id_of.size(); }
+	const int* begin(int u) const { return targets.data() + offsets[u]; }
+	int degree(int u) const { return offsets[u + 1] - offsets[u]; }
+};
+
+template <typename vertex> oriented_adjacency::oriented_adjacency(const csr_graph<vertex>& c) {
+	const int n = c.num_vertices();
+	id_of.resize(n);
+	std::iota(id_of.begin(), id_of.end(), 0);
+	std::stable_sort(id_of.begin(), id_of.end(), [&](int a, int b) { return c.degree(a) < c.degree(b); });
+	std::vector<int> rank(n);
+	for (int r = 0; r < n; ++r) rank[id_of[r]] = r;
+
+	offsets.assign(n + 1, 0);
+	for (int r = 0; r < n; ++r) {
+		int u = id_of[r];
+		for (auto w = c.neighbours_begin(u); w != c.neighbours_end(u); ++w) if (rank[*w] > r) ++offsets[r + 1];
+	}
+	for (int r = 0; r < n; ++r) offsets[r + 1] += offsets[r];
+	targets.resize(offsets.back());
+	for (int r = 0; r < n; ++r) {
+		int* out = targets.data() + offsets[r];
+		int u = id_of[r];
+		for (auto w = c.neighbours_begin(u); w != c.neighbours_end(u); ++w) if (rank[*w] > r) *out++ = rank[*w];
+		std::sort(targets.data() + offsets[r], out);
+	}
+}
+
+// Returns the number of triangles in c, counting the vertices in parallel.
+template <typename vertex>
+long long total_triangles(const csr_graph<vertex>& c, thread_pool& pool) {
+	oriented_adjacency adj(c);
+	std::vector<long long> partial(pool.size(), 0);
+	pool.parallel_for(0, adj.size(), 256, [&](int begin, int end, int worker) {
+		long long found = 0;
+		for (int u = begin; u < end; ++u) {
+			for (int i = 0; i < adj.degree(u); ++i) {
+				int v = adj.begin(u)[i];
+				found += intersect_sorted(adj.begin(u), adj.degree(u), adj.begin(v), adj.degree(v), [](int) {});
+			}
+		}
+		partial[worker] += found;
+	});
+	return std::accumulate(partial.begin(), partial.end(), 0LL);
+}
+
+// Returns the number of triangles through every id of c. A triangle is found once, from its lowest
+// ranked corner u while scanning its edge to the middle corner v, and credits all three corners:
+// u locally, v and the matched top corner with relaxed atomic additions.
+template <typename vertex>
+std::vector<long long> triangle_count_ids(const csr_graph<vertex>& c, thread_pool& pool) {
+	oriented_adjacency adj(c);
+	const int n = adj.size();
+	std::vector<std::atomic<long long>> by_rank(n);
+	pool.parallel_for(0, n, 4096, [&](int begin, int end, int) {
+		for (int u = begin; u < end; ++u) by_rank[u].store(0, std::memory_order_relaxed);
+	});
+	pool.parallel_for(0, n, 256, [&](int begin, int end, int) {
+		for (int u = begin; u < end; ++u) {
+			long long at_u = 0;
+			for (int i = 0; i < adj.degree(u); ++i) {
+				int v = adj.begin(u)[i];
+				int common = intersect_sorted(adj.begin(u), adj.degree(u), adj.begin(v), adj.degree(v), [&](int w) {
+					by_rank[w].fetch_add(1, std::memory_order_relaxed);
+				});
+				if (common) by_rank[v].fetch_add(common, std::memory_order_relaxed);
+				at_u += common;
+			}
+			if (at_u) by_rank[u].fetch_add(at_u, std::memory_order_relaxed);
+		}
+	});
+	std::vector<long long> triangles(n);
+	for (int r = 0; r < n; ++r) triangles[adj.id_of[r]] = by_rank[r].load(std::memory_order_relaxed);
+	return triangles;
+}
+
+// Triangle counts and local clustering coefficients of a graph. A vertex's clustering coefficient
+// is the fraction of pairs of its neighbours that are adjacent, and 0 with fewer than two neighbours.
+template <typename vertex>
+struct triangle_statistics {
+	long long total = 0;
+	std::unordered_map<vertex, long long> triangles;
+	std::unordered_map<vertex, double> clustering;
+	double average_clustering = 0;
+};
+
+// Counts the triangles of g, in total and through each vertex, along with its clustering coefficients.
+template <typename vertex>
+triangle_statistics<vertex> count_triangles(const weighted_graph<vertex>& g, thread_pool& pool) {
+	csr_graph<vertex> c(g);
+	std::vector<long long> triangles = triangle_count_ids(c, pool);
+	triangle_statistics<vertex> result;
+	result.triangles.reserve(c.num_vertices());
+	result.clustering.reserve(c.num_vertices());
+	for (int u = 0; u < c.num_vertices(); ++u) {
+		long long d = c.degree(u);
+		double coefficient = d < 2 ? 0 : 2.0 * triangles[u] / (d * (d - 1));
+		result.total += triangles[u];
+		result.triangles[c.vertex_at(u)] = triangles[u];
+		result.clustering[c.vertex_at(u)] = coefficient;
+		result.average_clustering += coefficient;
+	}
+	// Each triangle was credited to all three of its corners
+	result.total /= 3;
+	if (c.num_vertices() > 0) result.average_clustering /= c.num_vertices();
+	return result;
+}
+
+#endif
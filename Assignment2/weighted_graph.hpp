@@ -2,10 +2,13 @@
 #define WEIGHTED_GRAPH_H
 
 #include <vector>
+#include <algorithm>
 #include <queue>
 #include <stack>
 #include <unordered_set>
 #include <unordered_map>
+#include "disjoint_set.hpp"
+#include "graph_observer.hpp"
 
 template <typename vertex>
 class weighted_graph {
@@ -23,6 +26,25 @@ class weighted_graph {
 	size_t n{0};
 	size_t m{0};
 	
+	// Connectivity maintained as vertices and edges are added, see track_connectivity.
+	// Removals leave it stale, and it is rebuilt on the next query.
+	bool tracking{false};
+	mutable bool connectivity_stale{false};
+	mutable disjoint_set components;
+	mutable std::unordered_map<vertex, int> component_index;
+	
+	void find_connectivity(disjoint_set&, std::unordered_map<vertex, int>&) const;
+	void rebuild_connectivity() const;
+	
+	// Observers belong to one particular graph, so copies of a graph start without any
+	struct observer_list {
+		std::vector<graph_observer<vertex>*> items;
+		observer_list() {}
+		observer_list(const observer_list&) {}
+		observer_list& operator=(const observer_list&) { return *this; }
+	};
+	observer_list observers;
+	
 	public:
 	
 	bool are_adjacent(const vertex&, const vertex&) const;
@@ -30,6 +52,7 @@ class weighted_graph {
 	
 	void add_vertex(const vertex&);
 	void add_edge(const vertex&, const vertex&, const int&);
+	void reserve(size_t);
 	
 	void remove_vertex(const vertex&);
 	void remove_edge(const vertex&, const vertex&);
@@ -42,6 +65,14 @@ class weighted_graph {
 	int num_edges() const;
 	int total_weight() const;
 	
+	void track_connectivity(bool);
+	bool tracks_connectivity() const;
+	bool same_component(const vertex&, const vertex&) const;
+	int num_components() const;
+	
+	void attach(graph_observer<vertex>*);
+	void detach(graph_observer<vertex>*);
+	
 	graph_iterator begin();
 	graph_iterator end();
 	const_graph_iterator begin() const;
@@ -84,6 +115,8 @@ template <typename vertex>	void weighted_graph<vertex>::add_vertex(const vertex&
 		vertices.insert(v);
 		adj_list.insert({v, std::unordered_map<vertex,int>()});
 		n++;
+		if (tracking && !connectivity_stale) component_index[v] = components.add();
+		for (auto o : observers.items) o->vertex_added(v);
 	}
 }
 
@@ -92,36 +125,69 @@ template <typename vertex>	void weighted_graph<vertex>::add_edge(const vertex& u
 		adj_list[u][v] = weight;
 		adj_list[v][u] = weight;
 		m++;
+		if (tracking && !connectivity_stale) components.unite(component_index.at(u), component_index.at(v));
+		for (auto o : observers.items) o->edge_added(u, v, weight);
 	}
 }
 	
+template <typename vertex>	void weighted_graph<vertex>::reserve(size_t count) {
+	// Make room for count vertices up front, so filling a graph of known size never rehashes
+	vertices.reserve(count);
+	adj_list.reserve(count);
+}
+	
 template <typename vertex>	void weighted_graph<vertex>::remove_vertex(const vertex& u) {
-	if (has_vertex(u)){ 
-		n--;
-		m -= degree(u);
-	}
+	// Copy u first, as it may refer to the very key that is about to be erased
+	vertex removed = u;
+	auto& edges = adj_list.at(removed);
+	// A union-find cannot split sets, so rebuild lazily on the next query
+	connectivity_stale = true;
 	
-	for (auto itr = neighbours_begin(u); itr != neighbours_end(u); ++itr){
-		adj_list.at(itr->first).erase(u);
+	// One edge at a time, so each observer sees the graph as it was less just that edge
+	while (!edges.empty()){
+		vertex w = edges.begin()->first;
+		int weight = edges.begin()->second;
+		edges.erase(edges.begin());
+		adj_list.at(w).erase(removed);
+		m--;
+		for (auto o : observers.items) o->edge_removed(removed, w, weight);
 	}
 	
-	vertices.erase(u);
-	adj_list.erase(u);
+	vertices.erase(removed);
+	adj_list.erase(removed);
+	n--;
+	for (auto o : observers.items) o->vertex_removed(removed);
 }
 
 
 template <typename vertex>	void weighted_graph<vertex>::remove_edge(const vertex& u, const vertex& v) {
 	if (has_vertex(u) && has_vertex(v)){
-		if (adj_list.at(u).count(v) > 0) m--;
-		adj_list.at(u).erase(v);
-		adj_list.at(v).erase(u);
+		if (adj_list.at(u).count(v) > 0){
+			m--;
+			connectivity_stale = true;
+			// Copy the endpoints first, as either may refer to a key that is about to be erased
+			vertex a = u;
+			vertex b = v;
+			int weight = adj_list.at(a).at(b);
+			adj_list.at(a).erase(b);
+			adj_list.at(b).erase(a);
+			for (auto o : observers.items) o->edge_removed(a, b, weight);
+		}
 	}
 }
 
 template <typename vertex>	void weighted_graph<vertex>::set_edge_weight(const vertex& u, const vertex& v, const int& weight) {
 	if (has_vertex(u) && has_vertex(v)){
+		bool existed = adj_list[u].count(v) > 0;
+		int old_weight = existed ? adj_list[u][v] : 0;
 		adj_list[u][v] = weight;
 		adj_list[v][u] = weight;
+		// Setting the weight of a missing edge creates it
+		if (tracking && !connectivity_stale) components.unite(component_index.at(u), component_index.at(v));
+		for (auto o : observers.items){
+			if (existed) o->edge_weight_changed(u, v, old_weight, weight);
+			else o->edge_added(u, v, weight);
+		}
 	}
 }
 
@@ -148,4 +214,70 @@ template <typename vertex>	int weighted_graph<vertex>::total_weight() const {
 	return total/2;
 }
 
+// Turns incremental connectivity on or off. While it is on, add_vertex and add_edge keep a
+// union-find up to date, so same_component and num_components answer in near-constant time.
+// Those queries then update the union-find even though they are const, so while it is on they,
+// and is_connected and is_reachable, must not be called from more than one thread at once.
+// With it off they only read the graph.
+template <typename vertex>	void weighted_graph<vertex>::track_connectivity(bool enabled) {
+	tracking = enabled;
+	connectivity_stale = true;
+	components = disjoint_set();
+	component_index.clear();
+	if (tracking) rebuild_connectivity();
+}
+
+template <typename vertex>	bool weighted_graph<vertex>::tracks_connectivity() const { return tracking; }
+
+// Fills sets and index with the connected components of the graph from scratch.
+template <typename vertex>	void weighted_graph<vertex>::find_connectivity(disjoint_set& sets, std::unordered_map<vertex, int>& index) const {
+	sets = disjoint_set(n);
+	index.clear();
+	index.reserve(n);
+	for (auto u : vertices) index.insert({u, index.size()});
+	for (auto u : vertices){
+		for (auto itr = cneighbours_begin(u); itr != cneighbours_end(u); ++itr){
+			sets.unite(index.at(u), index.at(itr->first));
+		}
+	}
+}
+
+template <typename vertex>	void weighted_graph<vertex>::rebuild_connectivity() const {
+	find_connectivity(components, component_index);
+	connectivity_stale = false;
+}
+
+// Returns true if there is a path between u and v. Without tracking this costs a full pass over the graph.
+template <typename vertex>	bool weighted_graph<vertex>::same_component(const vertex& u, const vertex& v) const {
+	if (!(has_vertex(u) && has_vertex(v))) return false;
+	if (!tracking){
+		disjoint_set sets;
+		std::unordered_map<vertex, int> index;
+		find_connectivity(sets, index);
+		return sets.same_set(index.at(u), index.at(v));
+	}
+	if (connectivity_stale) rebuild_connectivity();
+	return components.same_set(component_index.at(u), component_index.at(v));
+}
+
+// Returns the number of connected components. Without tracking this costs a full pass over the graph.
+template <typename vertex>	int weighted_graph<vertex>::num_components() const {
+	if (!tracking){
+		disjoint_set sets;
+		std::unordered_map<vertex, int> index;
+		find_connectivity(sets, index);
+		return sets.num_sets();
+	}
+	if (connectivity_stale) rebuild_connectivity();
+	return components.num_sets();
+}
+
+// Registers an observer to be told about every later change to the graph. The graph does not
+// own the observer, which must be detached before it is destroyed.
+template <typename vertex>	void weighted_graph<vertex>::attach(graph_observer<vertex>* o) { observers.items.push_back(o); }
+
+template <typename vertex>	void weighted_graph<vertex>::detach(graph_observer<vertex>* o) {
+	observers.items.erase(std::remove(observers.items.begin(), observers.items.end(), o), observers.items.end());
+}
+
 #endif